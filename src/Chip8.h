@@ -1,35 +1,224 @@
 #ifndef CHIP8_H
 #define CHIP8_H
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
+#include <memory>
 #include "components/TimerManager.h"
 #include "components/Display.h" 
 #include "components/Input.h" 
 
+class JitCompiler;
+class AotEngine;
+struct AotContext;
+class ExecutionTrace;
+class Profiler;
+struct SaveState;
+struct RomEntry;
+class RomLibrary;
+
+// Sprites dos dígitos hexadecimais (0-F), carregados a partir do endereço 0x000
+extern const uint8_t CHIP8_FONTSET[80];
+// Dígitos grandes 8x10 (0-F) do SUPER-CHIP/XO-CHIP (FX30), logo após a fonte pequena
+extern const uint8_t CHIP8_BIG_FONTSET[160];
+constexpr uint16_t BIG_FONT_ADDRESS = 0x050;
+
+// Máquina emulada: conjunto de instruções, quirks, memória e resolução
+enum class MachineProfile : uint8_t {
+    Chip8,     // CHIP-8 clássico: 64x32, 4 KB
+    SuperChip, // SUPER-CHIP 1.1: 128x64, rolagem, sprites 16x16, flags RPL
+    XoChip     // XO-CHIP: SUPER-CHIP + 64 KB, dois bit-planes, F000 NNNN
+};
+const char* machine_profile_name(MachineProfile profile); // "chip8", "schip" ou "xochip"
+bool parse_machine_profile(const char* name, MachineProfile& profile);
+
+// Motor de execução usado por run_cycles
+enum class CpuEngine {
+    Interpreter, // Cache pré-decodificado + handlers
+    Jit,         // Recompilador dinâmico x86-64 (fallback para o interpretador)
+    Aot          // Programa pré-compilado pelo chip8_aot para a ROM carregada (idem)
+};
+
 class Chip8 {
 public:
     Chip8(uint32_t frequency); 
+    ~Chip8();
+#ifndef CHIP8_HEADLESS
     void process_input(SDL_Event& event);
+    int map_key(SDL_Keycode key_code) const { return input.map_key(key_code); } // Tecla Chip-8 ou -1
+#endif
     void update_timers();
     void initialize();
-    void load_rom(const char* filename, uint16_t load_address = 0x200);
-    void cycle();
+    // Troca a máquina emulada e reinicializa a VM (chamar antes de load_rom).
+    // O JIT é desligado: ele só traduz o CHIP-8 clássico.
+    void set_machine(MachineProfile profile);
+    MachineProfile get_machine() const { return machine; }
+    void load_rom(const char* filename, uint16_t load_address = 0x200); // Aceita "arquivo.zip:ENTRADA"
+    void load_rom(const RomLibrary& library, const RomEntry& entry, uint16_t load_address = 0x200);
+    void load_program(const uint8_t* program, size_t size, uint16_t load_address = 0x200); // Código já em memória (benchmarks)
+    void cycle(); // Uma instrução (run_cycles(1))
+    uint32_t run_cycles(uint32_t max_cycles); // Executa até max_cycles instruções (para em FX0A)
+    bool set_engine(CpuEngine engine);         // false se o motor não estiver disponível no host
+    CpuEngine get_engine() const { return jit ? CpuEngine::Jit : aot ? CpuEngine::Aot : CpuEngine::Interpreter; }
+    const JitCompiler* get_jit() const { return jit.get(); }
+    const AotEngine* get_aot() const { return aot.get(); }
+    // Trace binário das últimas instruções (com trace ligado run_cycles usa o interpretador)
+    void enable_trace(uint32_t capacity, const char* dump_path);
+    ExecutionTrace* get_trace() { return trace.get(); }
+    // Profiler por classe de opcode/endereço e tempo de CPU, render e timers
+    // (com o profiler ligado run_cycles também usa o interpretador)
+    void enable_profiler();
+    const Profiler* get_profiler() const { return profiler.get(); }
+    // Save state: snapshot completo em um bloco fixo, sem alocação (pode ser tirado a cada quadro)
+    void save_state(SaveState& state) const;
+    bool load_state(const SaveState& state); // false se o bloco for inválido (VM inalterada)
+#ifndef CHIP8_HEADLESS
     bool init_display_graphics(uint32_t scale); // Wrapper para display.init_graphics
-    void render_display();                       // Wrapper para display.render
+    void present_frame(const Framebuffer& frame); // Wrapper para display.present (thread da janela)
     void destroy_display_graphics();
+    bool init_audio(Waveform waveform);          // Wrapper para timers.init_audio
+    void destroy_audio();
+#endif
     void set_key_pressed(uint8_t key_value);
     void load_font_set();
     void execute_opcode(uint16_t opcode);
     uint16_t fetch_opcode();
     bool is_waiting_for_key() { return m_is_waiting_for_key; }
+    void set_key(uint8_t key, bool pressed); // Entrada sem SDL (scripts, runner)
+    void set_rng_seed(uint32_t seed);        // Semente do RNG da instância (CXNN)
+    uint16_t get_key_mask() const;           // Bit k = tecla k pressionada
+    uint64_t get_cycle_count() const { return cycle_count; } // Instruções desde initialize()
+    // Laços de espera pelo delay timer (FX07 / 3XNN ou 4XNN / JP de volta) pulados até o
+    // fim do lote: o estado final é idêntico ao da execução instrução a instrução
+    uint64_t get_idle_cycles_elided() const { return idle_cycles_elided; }
+    bool is_idle_loop(uint16_t jump_pc) const; // O JP em jump_pc fecha um laço de espera?
+    // Erros fatais da ROM (RET com a stack vazia, stack overflow): por padrão encerram o
+    // processo; com set_exit_on_fault(false) só esta VM para e run_cycles passa a retornar 0
+    void set_exit_on_fault(bool exit_on_fault) { this->exit_on_fault = exit_on_fault; }
+    bool is_faulted() const { return faulted; }
+    const char* get_fault_message() const { return fault_message; } // nullptr sem erro
+
+    // --- Acesso somente leitura ao estado (relatórios do modo headless) ---
+    uint16_t get_PC() const { return PC; }
+    uint16_t get_I() const { return I; }
+    uint8_t get_SP() const { return SP; }
+    uint8_t get_V(uint8_t index) const { return V[index & 0xF]; }
+    uint8_t get_delay_timer() const { return timers.get_delay_timer(); }
+    uint8_t get_sound_timer() const { return timers.get_sound_timer(); }
+    bool is_beeping() const { return timers.is_beeping(); }
+    BeepGate get_beep_gate() const { return timers.get_beep_gate(frame_cycles()); } // Bipe do quadro atual
+    uint16_t peek_opcode() const { return (memory[PC & 0xFFF] << 8) | memory[(PC + 1) & 0xFFF]; }
+    const Framebuffer& get_pixel_buffer() const { return display.pixel_buffer; }
+    const std::array<uint8_t, 65536>& get_memory() const { return memory; } // Tradutor AOT
+    bool take_frame(Framebuffer& out); // Copia o quadro se mudou desde a última cópia
+    uint8_t get_pixel(int x, int y) const { return display.get_pixel(x, y); } // Cor 0..3
+    int get_display_width() const { return display.pixel_buffer.width(); }
+    int get_display_height() const { return display.pixel_buffer.height(); }
 
+private:
+    friend class JitCompiler;
+    friend class AotEngine;
+    friend struct AotContext;
 
+    uint32_t interpret_cycles(uint32_t max_cycles);
+    uint32_t interpret_cycles_traced(uint32_t max_cycles);
+    uint32_t interpret_cycles_profiled(uint32_t max_cycles);
+    uint32_t run_cycles_skipping_idle(uint32_t max_cycles); // Interpretador/JIT com pulo de laços de espera
+    uint32_t skip_idle_loop(uint32_t max_cycles);
+    // Ciclos do quadro em andamento: os executados ou clock/60 se menos (FX0A), para o gate do bipe
+    uint32_t frame_cycles() const;
+    void fatal_error(const char* message); // Grava o trace (se ligado) e encerra ou para a VM
 
+    // --- Instrução pré-decodificada (cache de decodificação) ---
+    struct DecodedOp;
+    using OpHandler = void (Chip8::*)(const DecodedOp&);
+    struct DecodedOp {
+        OpHandler handler; // Handler já resolvido a partir do opcode
+        uint16_t opcode;
+        uint16_t nnn;
+        uint8_t x, y, n, nn;
+    };
+
+    static DecodedOp decode(uint16_t opcode, MachineProfile profile);
+    static const OpHandler ALU_TABLE[16];
+    static const OpHandler KEEP_VF_TABLE[4]; // 8xy0..8xy3 do SUPER-CHIP/XO-CHIP
+    size_t memory_size() const { return (size_t)memory_mask + 1; }
+    // Pula a próxima instrução (XO-CHIP: F000 NNNN ocupa 4 bytes)
+    void skip_next() {
+        PC += (long_skips && memory[PC & 0xFFF] == 0xF0 && memory[(PC + 1) & 0xFFF] == 0x00) ? 4 : 2;
+    }
+    void reset_decode_cache();
+    void invalidate_code(uint16_t address, uint16_t length); // Chamado nas escritas de FX33/FX55
+
+    // Handlers (um por instrução)
+    void op_predecode(const DecodedOp& op);
+    void op_cls(const DecodedOp& op);
+    void op_ret(const DecodedOp& op);
+    void op_sys(const DecodedOp& op);
+    void op_unknown(const DecodedOp& op);
+    void op_jp(const DecodedOp& op);
+    void op_jp_idle(const DecodedOp& op); // JP que fecha um laço de espera pelo DT
+    void op_call(const DecodedOp& op);
+    void op_se_byte(const DecodedOp& op);
+    void op_sne_byte(const DecodedOp& op);
+    void op_se_reg(const DecodedOp& op);
+    void op_ld_byte(const DecodedOp& op);
+    void op_add_byte(const DecodedOp& op);
+    void op_ld_reg(const DecodedOp& op);
+    void op_or(const DecodedOp& op);
+    void op_and(const DecodedOp& op);
+    void op_xor(const DecodedOp& op);
+    void op_add_reg(const DecodedOp& op);
+    void op_sub(const DecodedOp& op);
+    void op_shr(const DecodedOp& op);
+    void op_subn(const DecodedOp& op);
+    void op_shl(const DecodedOp& op);
+    void op_sne_reg(const DecodedOp& op);
+    void op_ld_i(const DecodedOp& op);
+    void op_jp_v0(const DecodedOp& op);
+    void op_rnd(const DecodedOp& op);
+    void op_drw(const DecodedOp& op);
+    void op_skp(const DecodedOp& op);
+    void op_sknp(const DecodedOp& op);
+    void op_ld_vx_dt(const DecodedOp& op);
+    void op_ld_key(const DecodedOp& op);
+    void op_ld_dt(const DecodedOp& op);
+    void op_ld_st(const DecodedOp& op);
+    void op_add_i(const DecodedOp& op);
+    void op_ld_font(const DecodedOp& op);
+    void op_ld_bcd(const DecodedOp& op);
+    void op_store_regs(const DecodedOp& op);
+    void op_load_regs(const DecodedOp& op);
+
+    // SUPER-CHIP / XO-CHIP
+    void op_scroll_down(const DecodedOp& op);   // 00CN
+    void op_scroll_up(const DecodedOp& op);     // 00DN (XO-CHIP)
+    void op_scroll_right(const DecodedOp& op);  // 00FB
+    void op_scroll_left(const DecodedOp& op);   // 00FC
+    void op_exit(const DecodedOp& op);          // 00FD
+    void op_lores(const DecodedOp& op);         // 00FE
+    void op_hires(const DecodedOp& op);         // 00FF
+    void op_ld_reg_keep_vf(const DecodedOp& op); // 8xy0..8xy3 sem zerar VF
+    void op_or_keep_vf(const DecodedOp& op);
+    void op_and_keep_vf(const DecodedOp& op);
+    void op_xor_keep_vf(const DecodedOp& op);
+    void op_jp_vx(const DecodedOp& op);         // Bxnn (SUPER-CHIP)
+    void op_drw_ext(const DecodedOp& op);       // Dxyn/Dxy0 com hires, planos e recorte
+    void op_save_range(const DecodedOp& op);    // 5xy2 (XO-CHIP)
+    void op_load_range(const DecodedOp& op);    // 5xy3 (XO-CHIP)
+    void op_ld_i_long(const DecodedOp& op);     // F000 NNNN (XO-CHIP)
+    void op_plane(const DecodedOp& op);         // FN01 (XO-CHIP)
+    void op_audio_pattern(const DecodedOp& op); // F002 (XO-CHIP)
+    void op_ld_big_font(const DecodedOp& op);   // Fx30
+    void op_pitch(const DecodedOp& op);         // Fx3A (XO-CHIP)
+    void op_store_regs_keep_i(const DecodedOp& op); // Fx55/Fx65 sem incrementar I (SUPER-CHIP)
+    void op_load_regs_keep_i(const DecodedOp& op);
+    void op_store_flags(const DecodedOp& op);   // Fx75
+    void op_load_flags(const DecodedOp& op);    // Fx85
 
-private:
     // Core CPU State
-    std::array<uint8_t, 4096> memory;   
+    std::array<uint8_t, 65536> memory;  // 4 KB usados no CHIP-8/SUPER-CHIP, 64 KB no XO-CHIP
     uint8_t V[16];                      
     uint16_t I;                          
     uint16_t PC;                         
@@ -42,7 +231,30 @@ private:
     uint32_t cpu_frequency_hz;
     bool m_is_waiting_for_key;
     uint8_t key_register_to_load;
-    
+    std::array<DecodedOp, 4096> decode_cache; // Uma entrada por endereço de memória
+    std::unique_ptr<JitCompiler> jit;         // Presente apenas com CpuEngine::Jit
+    std::unique_ptr<AotEngine> aot;           // Presente apenas com CpuEngine::Aot
+    std::unique_ptr<ExecutionTrace> trace;    // Presente apenas com o trace ligado
+    std::unique_ptr<Profiler> profiler;       // Presente apenas com o profiler ligado
+    uint32_t rng_state;                       // Estado do xorshift32 usado por CXNN
+    uint64_t cycle_count;                     // Total executado por run_cycles
+    uint64_t idle_cycles_elided;              // Parte de cycle_count pulada em laços de espera
+    bool idle_loop_hit;                       // op_jp_idle: o lote para e o laço é pulado
+    bool sound_timer_written;                 // op_ld_st: o lote para e o ciclo da escrita vai para o bipe
+    uint64_t frame_start_cycle;               // cycle_count no último tick de 60Hz
+    bool exit_on_fault;                       // fatal_error encerra o processo (padrão)
+    bool faulted;                             // fatal_error parou a VM: o lote para
+    const char* fault_message;                // Mensagem do erro fatal (faulted)
+    MachineProfile machine;
+    uint16_t memory_mask;                     // Endereços via I: 0xFFF ou 0xFFFF (XO-CHIP)
+    bool long_skips;                          // XO-CHIP: skips pulam F000 NNNN inteiro
+    uint8_t plane_mask;                       // Planos afetados por CLS/DXYN/rolagens (FN01)
+    uint8_t rpl[16];                          // Flags RPL (Fx75/Fx85)
+    uint8_t audio_pattern[16];                // Padrão de áudio do XO-CHIP (F002), guardado
+    uint8_t audio_pitch;                      // Fx3A, guardado
+
+    uint8_t next_random();
+
 };
 
 #endif // CHIP8_H
\ No newline at end of file
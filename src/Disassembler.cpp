@@ -0,0 +1,72 @@
+#include "Disassembler.h"
+#include <cstdio>
+
+static std::string unknown_opcode(uint16_t opcode) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "DW 0x%04X", opcode);
+    return text;
+}
+
+std::string disassemble(uint16_t opcode) {
+    const unsigned x = (opcode >> 8) & 0xF;
+    const unsigned y = (opcode >> 4) & 0xF;
+    const unsigned n = opcode & 0xF;
+    const unsigned nn = opcode & 0xFF;
+    const unsigned nnn = opcode & 0xFFF;
+    char text[32];
+
+    switch (opcode >> 12) {
+        case 0x0:
+            if (opcode == 0x00E0) return "CLS";
+            if (opcode == 0x00EE) return "RET";
+            std::snprintf(text, sizeof(text), "SYS 0x%03X", nnn);
+            break;
+        case 0x1: std::snprintf(text, sizeof(text), "JP 0x%03X", nnn); break;
+        case 0x2: std::snprintf(text, sizeof(text), "CALL 0x%03X", nnn); break;
+        case 0x3: std::snprintf(text, sizeof(text), "SE V%X, 0x%02X", x, nn); break;
+        case 0x4: std::snprintf(text, sizeof(text), "SNE V%X, 0x%02X", x, nn); break;
+        case 0x5:
+            if (n != 0) return unknown_opcode(opcode);
+            std::snprintf(text, sizeof(text), "SE V%X, V%X", x, y);
+            break;
+        case 0x6: std::snprintf(text, sizeof(text), "LD V%X, 0x%02X", x, nn); break;
+        case 0x7: std::snprintf(text, sizeof(text), "ADD V%X, 0x%02X", x, nn); break;
+        case 0x8: {
+            static const char* const ALU_NAMES[16] = {
+                "LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", "SUBN",
+                nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "SHL", nullptr
+            };
+            if (!ALU_NAMES[n]) return unknown_opcode(opcode);
+            std::snprintf(text, sizeof(text), "%s V%X, V%X", ALU_NAMES[n], x, y);
+            break;
+        }
+        case 0x9:
+            if (n != 0) return unknown_opcode(opcode);
+            std::snprintf(text, sizeof(text), "SNE V%X, V%X", x, y);
+            break;
+        case 0xA: std::snprintf(text, sizeof(text), "LD I, 0x%03X", nnn); break;
+        case 0xB: std::snprintf(text, sizeof(text), "JP V0, 0x%03X", nnn); break;
+        case 0xC: std::snprintf(text, sizeof(text), "RND V%X, 0x%02X", x, nn); break;
+        case 0xD: std::snprintf(text, sizeof(text), "DRW V%X, V%X, %u", x, y, n); break;
+        default: // 0xE e 0xF (o decodificador do Chip8 aceita SKP/SKNP nos dois grupos)
+            switch (nn) {
+                case 0x9E: std::snprintf(text, sizeof(text), "SKP V%X", x); break;
+                case 0xA1: std::snprintf(text, sizeof(text), "SKNP V%X", x); break;
+                default:
+                    if ((opcode >> 12) == 0xE) return unknown_opcode(opcode);
+                    switch (nn) {
+                        case 0x07: std::snprintf(text, sizeof(text), "LD V%X, DT", x); break;
+                        case 0x0A: std::snprintf(text, sizeof(text), "LD V%X, K", x); break;
+                        case 0x15: std::snprintf(text, sizeof(text), "LD DT, V%X", x); break;
+                        case 0x18: std::snprintf(text, sizeof(text), "LD ST, V%X", x); break;
+                        case 0x1E: std::snprintf(text, sizeof(text), "ADD I, V%X", x); break;
+                        case 0x29: std::snprintf(text, sizeof(text), "LD F, V%X", x); break;
+                        case 0x33: std::snprintf(text, sizeof(text), "LD B, V%X", x); break;
+                        case 0x55: std::snprintf(text, sizeof(text), "LD [I], V%X", x); break;
+                        case 0x65: std::snprintf(text, sizeof(text), "LD V%X, [I]", x); break;
+                        default: return unknown_opcode(opcode);
+                    }
+            }
+    }
+    return text;
+}
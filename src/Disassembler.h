@@ -0,0 +1,11 @@
+#ifndef DISASSEMBLER_H
+#define DISASSEMBLER_H
+
+#include <cstdint>
+#include <string>
+
+// Mnemônico de um opcode no estilo de Cowgod (ex.: "LD V3, 0x1F", "DRW V0, V1, 5").
+// Opcodes sem instrução correspondente viram "DW 0xNNNN".
+std::string disassemble(uint16_t opcode);
+
+#endif // DISASSEMBLER_H
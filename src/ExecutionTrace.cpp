@@ -0,0 +1,130 @@
+#include "ExecutionTrace.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static std::atomic<ExecutionTrace*> signal_trace{nullptr};
+static volatile std::sig_atomic_t dump_requested = 0;
+
+ExecutionTrace::ExecutionTrace(uint32_t capacity, const char* dump_path)
+    : mask(0), recorded(0), pending_pc(0), pending_opcode(0), before{0, 0}
+{
+    uint32_t size = 1;
+    while (size < capacity && size < (1u << 30)) size <<= 1;
+    records.resize(size);
+    mask = size - 1;
+    std::snprintf(path, sizeof(path), "%s", dump_path);
+}
+
+// Escrita completa com write(): sem alocação nem stdio, pode rodar em handler de sinal
+static bool write_all(int fd, const void* data, size_t size) {
+    const char* bytes = (const char*)data;
+    while (size > 0) {
+#ifdef _WIN32
+        int written = _write(fd, bytes, (unsigned)size);
+#else
+        ssize_t written = ::write(fd, bytes, size);
+#endif
+        if (written <= 0) return false;
+        bytes += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+bool ExecutionTrace::dump(const char* file_path) const {
+#ifdef _WIN32
+    int fd = _open(file_path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+    int fd = ::open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (fd < 0) return false;
+
+    const uint64_t capacity = mask + 1;
+    const uint64_t count = recorded < capacity ? recorded : capacity;
+    TraceFileHeader header = {{'C', '8', 'T', 'R'}, TRACE_FILE_VERSION, (uint16_t)sizeof(TraceRecord),
+                              (uint32_t)count, 0, recorded};
+
+    // Do mais antigo ao mais novo: o ring pode ter dado a volta
+    const uint64_t oldest = recorded - count;
+    const uint64_t first_index = oldest & mask;
+    const uint64_t first_part = (first_index + count <= capacity) ? count : capacity - first_index;
+
+    bool ok = write_all(fd, &header, sizeof(header))
+           && write_all(fd, &records[first_index], first_part * sizeof(TraceRecord))
+           && write_all(fd, &records[0], (count - first_part) * sizeof(TraceRecord));
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+    return ok;
+}
+
+bool ExecutionTrace::load(const char* file_path, TraceFileHeader* header, std::vector<TraceRecord>* out) {
+    FILE* file = std::fopen(file_path, "rb");
+    if (!file) return false;
+    bool ok = std::fread(header, sizeof(*header), 1, file) == 1
+           && std::memcmp(header->magic, "C8TR", 4) == 0
+           && header->version == TRACE_FILE_VERSION
+           && header->record_size == sizeof(TraceRecord);
+    if (ok) {
+        // O contador vem do arquivo: só aloca o que os bytes restantes realmente contêm
+        const long data_start = std::ftell(file);
+        ok = data_start >= 0 && std::fseek(file, 0, SEEK_END) == 0;
+        const long file_end = ok ? std::ftell(file) : -1;
+        ok = ok && file_end >= data_start && std::fseek(file, data_start, SEEK_SET) == 0;
+        if (ok && (uint64_t)header->record_count * sizeof(TraceRecord) > (uint64_t)(file_end - data_start)) {
+            std::fprintf(stderr, "ERRO: Trace truncado: %u registros no cabecalho, %llu no arquivo: %s\n",
+                         header->record_count, (unsigned long long)((file_end - data_start) / sizeof(TraceRecord)),
+                         file_path);
+            ok = false;
+        }
+    }
+    if (ok) {
+        out->resize(header->record_count);
+        ok = std::fread(out->data(), sizeof(TraceRecord), out->size(), file) == out->size();
+    }
+    std::fclose(file);
+    return ok;
+}
+
+#ifndef _WIN32
+static void handle_dump_request(int) {
+    dump_requested = 1;
+}
+
+static void handle_crash(int signal_number) {
+    ExecutionTrace* trace = signal_trace.load();
+    if (trace) {
+        trace->dump();
+        static const char message[] = "ERRO FATAL: sinal recebido, trace de execucao gravado.\n";
+        write_all(STDERR_FILENO, message, sizeof(message) - 1);
+    }
+    std::signal(signal_number, SIG_DFL);
+    std::raise(signal_number);
+}
+#endif
+
+void ExecutionTrace::install_signal_handlers(ExecutionTrace* trace) {
+    signal_trace.store(trace);
+#ifndef _WIN32
+    std::signal(SIGUSR1, handle_dump_request);
+    std::signal(SIGSEGV, handle_crash);
+    std::signal(SIGBUS, handle_crash);
+    std::signal(SIGFPE, handle_crash);
+    std::signal(SIGABRT, handle_crash);
+#endif
+}
+
+bool ExecutionTrace::consume_dump_request() {
+    if (!dump_requested) return false;
+    dump_requested = 0;
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef EXECUTIONTRACE_H
+#define EXECUTIONTRACE_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Registro binário de uma instrução executada (16 bytes, tamanho fixo)
+struct TraceRecord {
+    uint32_t sequence;   // Número da instrução desde que o trace foi ligado (32 bits baixos)
+    uint16_t pc;
+    uint16_t opcode;
+    uint16_t changed;    // Bit r = V[r] alterado pela instrução
+    uint16_t i;          // I após a instrução
+    uint8_t values[2];   // Novos valores dos dois primeiros registradores alterados
+    uint8_t sp;          // SP após a instrução
+    uint8_t flags;       // TRACE_FLAG_*
+};
+static_assert(sizeof(TraceRecord) == 16, "TraceRecord deve ter 16 bytes");
+
+constexpr uint8_t TRACE_FLAG_FAULT = 0x01;    // Instrução que disparou um erro fatal
+constexpr uint8_t TRACE_FLAG_KEY_WAIT = 0x02; // Instrução deixou a CPU aguardando tecla (FX0A)
+
+// Cabeçalho do arquivo de dump (seguido de record_count registros, do mais antigo ao mais novo)
+struct TraceFileHeader {
+    char magic[4];          // "C8TR"
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t record_count;
+    uint32_t reserved;
+    uint64_t total_recorded; // Instruções registradas desde o início (inclui as sobrescritas)
+};
+static_assert(sizeof(TraceFileHeader) == 24, "TraceFileHeader deve ter 24 bytes");
+
+constexpr uint16_t TRACE_FILE_VERSION = 1;
+constexpr uint32_t DEFAULT_TRACE_CAPACITY = 65536; // 1 MB de registros
+
+// Trace de execução: ring buffer pré-alocado com as últimas N instruções. O
+// interpretador chama begin() antes e commit() depois de cada instrução; a
+// diferença dos registradores é calculada com operações de 64 bits, sem laço.
+// O dump é gravado em erros fatais, em sinais (SIGUSR1 sob pedido, falhas
+// como SIGSEGV imediatamente) ou quando solicitado.
+class ExecutionTrace {
+public:
+    ExecutionTrace(uint32_t capacity, const char* dump_path); // capacity é arredondada para potência de 2
+
+    void begin(uint16_t pc, uint16_t opcode, const uint8_t* V) {
+        pending_pc = pc;
+        pending_opcode = opcode;
+        std::memcpy(before, V, 16);
+    }
+
+    void commit(const uint8_t* V, uint16_t I, uint8_t SP, uint8_t flags) {
+        uint64_t after[2];
+        std::memcpy(after, V, 16);
+        uint16_t changed = (uint16_t)(changed_bytes(before[0] ^ after[0]) | (changed_bytes(before[1] ^ after[1]) << 8));
+
+        TraceRecord& record = records[recorded & mask];
+        record.sequence = (uint32_t)recorded;
+        record.pc = pending_pc;
+        record.opcode = pending_opcode;
+        record.changed = changed;
+        record.i = I;
+        record.sp = SP;
+        record.flags = flags;
+        record.values[0] = changed ? V[__builtin_ctz(changed)] : 0;
+        uint16_t rest = changed & (changed - 1);
+        record.values[1] = rest ? V[__builtin_ctz(rest)] : 0;
+        ++recorded;
+    }
+
+    bool dump() const { return dump(path); } // Grava no caminho configurado
+    bool dump(const char* file_path) const;  // Seguro para uso em handler de sinal (POSIX)
+    const char* get_path() const { return path; }
+    uint64_t get_recorded() const { return recorded; }
+
+    // Sinais: SIGUSR1 pede um dump (atendido em consume_dump_request, fora do
+    // handler); SIGSEGV/SIGBUS/SIGFPE/SIGABRT gravam o dump e encerram.
+    static void install_signal_handlers(ExecutionTrace* trace);
+    static bool consume_dump_request();
+
+    // Leitura de um dump (ferramenta de decodificação)
+    static bool load(const char* file_path, TraceFileHeader* header, std::vector<TraceRecord>* out);
+
+private:
+    // Bit k = byte k de diff diferente de zero
+    static uint8_t changed_bytes(uint64_t diff) {
+        diff |= diff >> 4;
+        diff |= diff >> 2;
+        diff |= diff >> 1;
+        diff &= 0x0101010101010101ULL;
+        return (uint8_t)((diff * 0x0102040810204080ULL) >> 56);
+    }
+
+    std::vector<TraceRecord> records;
+    uint64_t mask;
+    uint64_t recorded;
+    uint16_t pending_pc;
+    uint16_t pending_opcode;
+    uint64_t before[2];
+    char path[256];
+};
+
+#endif // EXECUTIONTRACE_H
@@ -0,0 +1,113 @@
+#include "FrameScheduler.h"
+#include <thread>
+
+using namespace std::chrono;
+
+// Margem final do quadro feita em espera ativa: cobre a granularidade do sleep do SO
+constexpr auto SPIN_MARGIN = microseconds(1500);
+
+FrameScheduler::FrameScheduler(uint32_t clock, uint32_t frames_per_second, uint32_t max_catch_up)
+    : clock_hz(clock),
+      frame_hz(frames_per_second),
+      max_catch_up_frames(max_catch_up ? max_catch_up : 1),
+      speed(1),
+      frame_period(duration_cast<Clock::duration>(duration<double>(1.0 / frames_per_second))),
+      start_time(Clock::now()),
+      next_deadline(start_time),
+      cycle_remainder(0),
+      executed_cycles(0),
+      emulated_frames(0),
+      dropped_frames(0),
+      woken(false)
+{}
+
+void FrameScheduler::start() {
+    start_time = Clock::now();
+    next_deadline = start_time;
+}
+
+void FrameScheduler::sleep_until(Clock::time_point deadline) const {
+    auto now = Clock::now();
+    if (deadline - now > SPIN_MARGIN) {
+        std::this_thread::sleep_for(deadline - now - SPIN_MARGIN);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+uint32_t FrameScheduler::wait_for_frames() {
+    sleep_until(next_deadline);
+    {
+        // Teclas chegadas durante o sono são aplicadas neste quadro: o aviso expira
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        woken = false;
+    }
+    return take_due_frames(Clock::now());
+}
+
+uint32_t FrameScheduler::wait_for_frames_blocked() {
+    // Um quadro antecipado por wake() deixa a emulação até um quadro à frente do
+    // relógio; só depois de voltar a essa distância outra tecla pode antecipar
+    std::this_thread::sleep_until(next_deadline - frame_period);
+    {
+        std::unique_lock<std::mutex> lock(wake_mutex);
+        wake_condition.wait_until(lock, next_deadline, [this] { return woken; });
+        woken = false;
+    }
+    auto now = Clock::now();
+    if (now < next_deadline) {
+        // Acordado por tecla: o quadro do próximo deadline é emulado agora
+        next_deadline += frame_period;
+        emulated_frames += 1;
+        return 1;
+    }
+    return take_due_frames(now);
+}
+
+void FrameScheduler::wake() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        woken = true;
+    }
+    wake_condition.notify_one();
+}
+
+uint32_t FrameScheduler::take_due_frames(Clock::time_point now) {
+    // Quadros vencidos desde o deadline (1 no caso normal, mais após um travamento)
+    uint64_t due = 1 + (uint64_t)((now - next_deadline) / frame_period);
+    uint32_t frames = (uint32_t)((due < max_catch_up_frames) ? due : max_catch_up_frames);
+
+    if (due > max_catch_up_frames) {
+        // Atraso grande demais: descarta o excedente e realinha o relógio
+        dropped_frames += due - max_catch_up_frames;
+        next_deadline = now + frame_period;
+    } else {
+        next_deadline += frame_period * frames;
+    }
+    if (speed > 1) frames *= speed;
+    emulated_frames += frames;
+    return frames;
+}
+
+bool FrameScheduler::take_extra_frame() {
+    if (speed != 0 || Clock::now() >= next_deadline) return false;
+    ++emulated_frames;
+    return true;
+}
+
+uint32_t FrameScheduler::cycles_for_frame() {
+    cycle_remainder += clock_hz;
+    uint32_t cycles = cycle_remainder / frame_hz;
+    cycle_remainder %= frame_hz;
+    return cycles;
+}
+
+double FrameScheduler::get_elapsed_seconds() const {
+    return duration_cast<duration<double>>(Clock::now() - start_time).count();
+}
+
+double FrameScheduler::get_achieved_hz() const {
+    double seconds = get_elapsed_seconds();
+    return (seconds > 0.0) ? (double)executed_cycles / seconds : 0.0;
+}
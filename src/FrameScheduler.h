@@ -0,0 +1,63 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Agendador por quadro (60Hz): a CPU executa clock_hz / 60 instruções em lote por
+// quadro, carregando a fração de ciclo entre quadros, e o host dorme uma única vez
+// por quadro (sleep até perto do deadline + espera ativa curta para precisão).
+// Após travamentos do host emula até max_catch_up_frames quadros atrasados de uma
+// vez; o restante é descartado para não entrar em espiral.
+//
+// Turbo: com velocidade N cada quadro real vale N quadros emulados; com velocidade
+// 0 (sem limite) o chamador emula quadros extras até o próximo deadline. Os timers
+// continuam avançando uma vez por quadro emulado.
+//
+// CPU parada (FX0A): wait_for_frames_blocked dorme até o deadline sem espera ativa e
+// acorda antes se outra thread chamar wake() (tecla nova), emulando o quadro na hora.
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FrameScheduler(uint32_t clock_hz, uint32_t frame_hz, uint32_t max_catch_up_frames);
+
+    void start();                 // Marca o início; o primeiro quadro vence imediatamente
+    uint32_t wait_for_frames();   // Aguarda o próximo deadline; retorna quadros a emular (1..max) × velocidade
+    uint32_t wait_for_frames_blocked(); // Idem, sem espera ativa; wake() antecipa o quadro
+    void wake();                  // Chamado por outra thread: encerra a espera bloqueada
+    bool take_extra_frame();      // Velocidade 0: true (e conta o quadro) enquanto o próximo deadline não chegou
+    void set_speed(uint32_t multiplier) { speed = multiplier; } // 1 = tempo real, N = N×, 0 = sem limite
+    uint32_t cycles_for_frame();  // Ciclos deste quadro (clock / frame_hz com acumulação fracionária)
+    void add_executed_cycles(uint64_t cycles) { executed_cycles += cycles; }
+
+    // Medições
+    double get_elapsed_seconds() const;
+    double get_achieved_hz() const; // Ciclos executados / tempo real decorrido
+    uint64_t get_executed_cycles() const { return executed_cycles; }
+    uint64_t get_emulated_frames() const { return emulated_frames; }
+    uint64_t get_dropped_frames() const { return dropped_frames; }
+
+private:
+    void sleep_until(Clock::time_point deadline) const;
+    uint32_t take_due_frames(Clock::time_point now);
+
+    uint32_t clock_hz;
+    uint32_t frame_hz;
+    uint32_t max_catch_up_frames;
+    uint32_t speed;
+    Clock::duration frame_period;
+    Clock::time_point start_time;
+    Clock::time_point next_deadline;
+    uint32_t cycle_remainder;   // Fração de ciclo (em unidades de 1/frame_hz)
+    uint64_t executed_cycles;
+    uint64_t emulated_frames;
+    uint64_t dropped_frames;
+    std::mutex wake_mutex;
+    std::condition_variable wake_condition;
+    bool woken;                 // wake() desde a última espera (protegido por wake_mutex)
+};
+
+#endif // FRAMESCHEDULER_H
@@ -0,0 +1,197 @@
+#include "Headless.h"
+#include "jit/JitCompiler.h"
+#include "aot/AotEngine.h"
+#include "Log.h"
+#include "ExecutionTrace.h"
+#include "WavWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+using namespace std::chrono;
+
+// Frequência dos periféricos (timers) em tempo emulado
+constexpr uint32_t HEADLESS_PERIPHERAL_HZ = 60;
+
+uint64_t hash_framebuffer(const Framebuffer& frame) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](uint64_t row) {
+        for (int byte = 7; byte >= 0; --byte) {
+            hash ^= (row >> (byte * 8)) & 0xFF;
+            hash *= 0x100000001b3ULL;
+        }
+    };
+    // Tela lores de um plano: só as 32 linhas de 64 bits (mesmo hash do CHIP-8 clássico)
+    for (int y = 0; y < CHIP8_HEIGHT; ++y) mix(frame.row(y));
+    bool extended = frame.hires != 0;
+    for (int y = 0; y < HIRES_HEIGHT && !extended; ++y) extended = frame.planes[1][y][0] | frame.planes[1][y][1];
+    if (!extended) return hash;
+    // Hires ou segundo plano em uso: entram o modo e o restante das linhas
+    mix(frame.hires);
+    for (int plane = 0; plane < FRAMEBUFFER_PLANES; ++plane) {
+        for (int y = 0; y < HIRES_HEIGHT; ++y) {
+            for (int word = 0; word < FRAMEBUFFER_ROW_WORDS; ++word) {
+                if (plane == 0 && word == 0 && y < CHIP8_HEIGHT) continue;
+                mix(frame.planes[plane][y][word]);
+            }
+        }
+    }
+    return hash;
+}
+
+static void print_report(const Chip8& emulator, const HeadlessResult& result) {
+    const uint64_t executed = result.cycles - result.idle_cycles;
+
+    std::cout << "\n=================================================" << std::endl;
+    std::cout << "RELATORIO HEADLESS" << std::endl;
+    std::cout << "Motivo de parada: " << result.exit_reason << std::endl;
+
+    // Framebuffer final ('#' = pixel ligado; 'o' e '@' = cores 2 e 3 do XO-CHIP)
+    static const char COLOR_CHARS[4] = { '.', '#', 'o', '@' };
+    const int width = emulator.get_display_width(), height = emulator.get_display_height();
+    for (int y = 0; y < height; ++y) {
+        std::string line(width, '.');
+        for (int x = 0; x < width; ++x) {
+            line[x] = COLOR_CHARS[emulator.get_pixel(x, y)];
+        }
+        std::cout << line << '\n';
+    }
+    std::cout << "Hash do framebuffer: 0x" << std::hex << std::setw(16) << std::setfill('0')
+              << hash_framebuffer(emulator.get_pixel_buffer()) << std::endl;
+
+    // Registradores
+    for (int i = 0; i < 16; ++i) {
+        std::cout << "V" << std::uppercase << std::hex << i << "=" << std::setw(2)
+                  << (int)emulator.get_V(i) << ((i % 8 == 7) ? '\n' : ' ');
+    }
+    std::cout << "I=" << std::setw(4) << emulator.get_I()
+              << " PC=" << std::setw(4) << emulator.get_PC()
+              << " SP=" << std::dec << (int)emulator.get_SP()
+              << " DT=" << (int)emulator.get_delay_timer()
+              << " ST=" << (int)emulator.get_sound_timer() << std::nouppercase << std::endl;
+
+    // Desempenho real do motor (sem limitação por sleep)
+    const JitCompiler* jit = emulator.get_jit();
+    const AotEngine* aot = emulator.get_aot();
+    std::cout << "Motor: " << (jit ? "jit" : aot ? "aot" : "interp") << std::endl;
+    if (jit) {
+        std::cout << "JIT: " << jit->get_blocks_compiled() << " blocos compilados, "
+                  << jit->get_blocks_invalidated() << " invalidados, "
+                  << jit->get_native_cycles() << " ciclos nativos" << std::endl;
+    }
+    if (aot) {
+        std::cout << "AOT: programa '" << aot->get_program().name << "', "
+                  << aot->get_native_cycles() << " ciclos nativos, "
+                  << aot->get_fallback_cycles() << " no interpretador" << std::endl;
+    }
+    std::cout << "Ciclos executados: " << executed << " (" << result.frames << " quadros de 60Hz)" << std::endl;
+    if (result.idle_cycles > 0) {
+        std::cout << "Ciclos pulados em lacos de espera: " << result.idle_cycles << std::endl;
+    }
+    std::cout << "Tempo de execucao: " << std::fixed << std::setprecision(6) << result.seconds << " s" << std::endl;
+    // Só instruções executadas: os ciclos pulados não custam tempo e inflariam a vazão
+    if (result.seconds > 0.0) {
+        std::cout << "Ciclos/s: " << std::setprecision(2) << (double)executed / result.seconds << std::endl;
+    }
+    std::cout << "=================================================" << std::endl;
+}
+
+static void apply_due_events(Chip8& emulator, const std::vector<InputEvent>* events, size_t* next_event,
+                             uint64_t frame, uint64_t cycle) {
+    // Eventos de quadros passados são sempre aplicados (a CPU pode estar parada em FX0A)
+    while (events && *next_event < events->size()
+           && ((*events)[*next_event].frame < frame
+               || ((*events)[*next_event].frame == frame && (*events)[*next_event].cycle <= cycle))) {
+        const InputEvent& event = (*events)[(*next_event)++];
+        emulator.set_key(event.key, event.pressed);
+    }
+}
+
+HeadlessResult execute_headless(Chip8& emulator, const HeadlessConfig& config) {
+    // Sem orçamento explícito a execução ainda precisa terminar
+    const uint64_t max_frames = (config.max_cycles == 0 && config.max_frames == 0)
+        ? DEFAULT_HEADLESS_FRAMES : config.max_frames;
+
+    const std::vector<InputEvent>* events = config.input_events;
+    size_t next_event = 0;
+
+    uint64_t cycles = 0;
+    uint64_t frames = 0;
+    uint32_t cycle_remainder = 0; // Fração de ciclo acumulada entre quadros
+    const char* exit_reason = nullptr;
+
+    const uint64_t idle_cycles_before = emulator.get_idle_cycles_elided();
+    auto start_time = steady_clock::now();
+
+    while (!exit_reason) {
+        if (max_frames != 0 && frames >= max_frames) {
+            exit_reason = "orcamento de quadros esgotado";
+            break;
+        }
+
+        // Eventos agendados para este quadro (até o ciclo atual)
+        apply_due_events(emulator, events, &next_event, frames, cycles);
+
+        // Ciclos por quadro = clock / 60, carregando a parte fracionária
+        cycle_remainder += config.clock_hz;
+        uint32_t frame_cycles = cycle_remainder / HEADLESS_PERIPHERAL_HZ;
+        cycle_remainder %= HEADLESS_PERIPHERAL_HZ;
+
+        if (config.max_cycles != 0 && cycles + frame_cycles >= config.max_cycles) {
+            frame_cycles = (uint32_t)(config.max_cycles - cycles);
+            exit_reason = "orcamento de ciclos esgotado";
+        }
+
+        // Um evento gravado no meio do quadro divide o lote no ciclo exato
+        uint32_t remaining = frame_cycles;
+        while (remaining > 0 && !emulator.is_waiting_for_key() && !emulator.is_faulted()) {
+            uint32_t chunk = remaining;
+            if (events && next_event < events->size() && (*events)[next_event].frame == frames
+                && (*events)[next_event].cycle > cycles) {
+                chunk = (uint32_t)std::min<uint64_t>(chunk, (*events)[next_event].cycle - cycles);
+            }
+            uint32_t executed = emulator.run_cycles(chunk);
+            cycles += executed;
+            remaining -= chunk;
+            if (executed < chunk) break; // FX0A: o restante do quadro é perdido, como na janela
+            apply_due_events(emulator, events, &next_event, frames, cycles);
+        }
+        bool more_input = events && next_event < events->size();
+        if (emulator.is_faulted()) {
+            exit_reason = "erro fatal da ROM"; // Só com set_exit_on_fault(false)
+        } else if (emulator.is_waiting_for_key() && !more_input) {
+            exit_reason = "ROM aguardando tecla (FX0A) sem entrada disponivel";
+        }
+        if (exit_reason) break;
+
+        // Laço de parada: JP para o próprio endereço nunca mais altera o estado
+        if (!more_input && emulator.peek_opcode() == (0x1000 | emulator.get_PC())) {
+            exit_reason = "ROM parada (salto para o proprio endereco)";
+            break;
+        }
+
+        if (config.audio_out) config.audio_out->write_tick(emulator.get_beep_gate()); // Antes do tick, como na janela
+        emulator.update_timers();
+        frames++;
+
+        // Dump do trace pedido por sinal (SIGUSR1)
+        if (emulator.get_trace() && ExecutionTrace::consume_dump_request()) {
+            emulator.get_trace()->dump();
+        }
+    }
+
+    auto end_time = steady_clock::now();
+    double seconds = duration_cast<duration<double>>(end_time - start_time).count();
+    return {exit_reason, cycles, emulator.get_idle_cycles_elided() - idle_cycles_before, frames, seconds};
+}
+
+int run_headless(Chip8& emulator, const HeadlessConfig& config, HeadlessResult* result_out) {
+    HeadlessResult result = execute_headless(emulator, config);
+    if (result_out) *result_out = result;
+    Log::flush(); // Mensagens da execução antes do relatório
+
+    print_report(emulator, result);
+    return 0;
+}
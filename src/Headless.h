@@ -0,0 +1,45 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <cstdint>
+#include <vector>
+#include "Chip8.h"
+#include "InputScript.h"
+
+class WavWriter;
+
+// Quantidade de quadros de 60Hz executados quando nenhum orçamento é informado (10s emulados)
+constexpr uint64_t DEFAULT_HEADLESS_FRAMES = 600;
+
+// Configuração do modo headless (sem janela, renderer ou dispositivo de áudio)
+struct HeadlessConfig {
+    uint32_t clock_hz;   // Frequência emulada: define quantos ciclos formam um quadro de 60Hz
+    uint64_t max_cycles; // Orçamento de ciclos (0 = sem limite)
+    uint64_t max_frames; // Orçamento de quadros de 60Hz (0 = sem limite)
+    const std::vector<InputEvent>* input_events; // Teclas por quadro/ciclo (roteiro ou gravação, opcional)
+    WavWriter* audio_out;                        // Bipe renderizado em tempo emulado (opcional)
+};
+
+// Resultado de uma execução headless
+struct HeadlessResult {
+    const char* exit_reason;
+    uint64_t cycles;      // Ciclos emulados (inclui os pulados em laços de espera)
+    uint64_t idle_cycles; // Parte de cycles pulada em laços de espera, sem executar instruções
+    uint64_t frames;
+    double seconds; // Tempo real gasto
+};
+
+// Hash FNV-1a do framebuffer: permite comparar execuções sem guardar a imagem
+uint64_t hash_framebuffer(const Framebuffer& frame);
+
+// Executa a VM na velocidade máxima do host, sem SDL, até esgotar o orçamento,
+// a ROM entrar em laço de parada (1NNN para si mesma) ou aguardar tecla (FX0A)
+// sem eventos futuros no roteiro. Não imprime nada: pode rodar em várias threads,
+// uma instância por thread.
+HeadlessResult execute_headless(Chip8& emulator, const HeadlessConfig& config);
+
+// execute_headless seguido do relatório com framebuffer, registradores e
+// ciclos/s. Retorna o código de saída; result_out (opcional) recebe o resultado.
+int run_headless(Chip8& emulator, const HeadlessConfig& config, HeadlessResult* result_out = nullptr);
+
+#endif // HEADLESS_H
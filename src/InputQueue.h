@@ -0,0 +1,51 @@
+#ifndef INPUTQUEUE_H
+#define INPUTQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+// Transição de tecla com o instante (ns, relógio da SDL) em que o SO a registrou
+struct TimedKeyEvent {
+    uint64_t timestamp_ns;
+    uint8_t key;    // 0x0-0xF
+    bool pressed;
+};
+
+// Fila SPSC sem locks (um produtor: a thread de eventos; um consumidor: quem
+// executa a CPU). Capacidade fixa, sem alocação; índices em linhas de cache
+// separadas para o produtor e o consumidor não disputarem a mesma linha.
+class InputQueue {
+public:
+    static constexpr uint32_t CAPACITY = 256; // Potência de 2
+
+    InputQueue() : head(0), tail(0) {}
+
+    // Produtor. false se a fila estiver cheia (evento descartado)
+    bool push(const TimedKeyEvent& event) {
+        const uint32_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        slots[position & (CAPACITY - 1)] = event;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: evento mais antigo sem removê-lo (false se vazia)
+    bool peek(TimedKeyEvent* event) const {
+        const uint32_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) return false;
+        *event = slots[position & (CAPACITY - 1)];
+        return true;
+    }
+
+    // Consumidor: remove o evento devolvido por peek
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> head; // Próximo a consumir
+    alignas(64) std::atomic<uint32_t> tail; // Próximo a produzir
+    TimedKeyEvent slots[CAPACITY];
+};
+
+#endif // INPUTQUEUE_H
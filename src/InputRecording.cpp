@@ -0,0 +1,127 @@
+#include "InputRecording.h"
+#include "Chip8.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+// Cabeçalho do arquivo (ordem de bytes do host, como o SaveState)
+struct RecordingHeader {
+    char magic[4];          // "C8IR"
+    uint16_t version;
+    uint8_t machine;        // MachineProfile (0 = CHIP-8: gravações antigas continuam válidas)
+    uint8_t reserved;
+    uint32_t seed;
+    uint32_t clock_hz;
+    uint64_t frames;
+    uint64_t cycles;
+    uint64_t framebuffer_hash;
+    uint32_t event_count;
+    uint32_t reserved2;
+};
+static_assert(sizeof(RecordingHeader) == 48, "RecordingHeader deve ter 48 bytes");
+
+constexpr uint16_t RECORDING_VERSION = 1;
+constexpr uint8_t RECORDED_KEY_PRESSED = 0x10;
+constexpr size_t RECORDED_EVENT_MIN_BYTES = 3; // Deltas de 1 byte cada + tecla
+
+static void write_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static bool read_varint(const std::vector<uint8_t>& data, size_t* position, uint64_t* value) {
+    *value = 0;
+    for (uint32_t shift = 0; shift < 64 && *position < data.size(); shift += 7) {
+        uint8_t byte = data[(*position)++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+bool InputRecording::save(const char* path) const {
+    RecordingHeader header = {{'C', '8', 'I', 'R'}, RECORDING_VERSION, machine, 0, seed, clock_hz,
+                              frames, cycles, framebuffer_hash, (uint32_t)events.size(), 0};
+    std::vector<uint8_t> data(sizeof(header));
+    std::memcpy(data.data(), &header, sizeof(header));
+
+    uint64_t last_frame = 0, last_cycle = 0;
+    for (const InputEvent& event : events) {
+        write_varint(data, event.frame - last_frame);
+        write_varint(data, event.cycle - last_cycle);
+        data.push_back((uint8_t)(event.key | (event.pressed ? RECORDED_KEY_PRESSED : 0)));
+        last_frame = event.frame;
+        last_cycle = event.cycle;
+    }
+
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cerr << "ERRO: Nao foi possivel criar a gravacao de entrada: " << path << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(data.data(), data.size(), 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) std::cerr << "ERRO: Falha ao gravar a gravacao de entrada: " << path << std::endl;
+    return ok;
+}
+
+bool InputRecording::load(const char* path) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        std::cerr << "ERRO: Nao foi possivel abrir a gravacao de entrada: " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    std::fclose(file);
+
+    RecordingHeader header;
+    if (data.size() < sizeof(header)) {
+        std::cerr << "ERRO: Gravacao de entrada invalida: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, "C8IR", 4) != 0 || header.version != RECORDING_VERSION || header.clock_hz == 0
+        || header.machine > (uint8_t)MachineProfile::XoChip) {
+        std::cerr << "ERRO: Gravacao de entrada invalida: " << path << std::endl;
+        return false;
+    }
+    // Cada evento ocupa ao menos 3 bytes (dois varints e a tecla): um contador maior
+    // que o arquivo comporta é corrompido e não pode virar uma reserva gigante
+    if (header.event_count > (data.size() - sizeof(header)) / RECORDED_EVENT_MIN_BYTES) {
+        std::cerr << "ERRO: Gravacao de entrada truncada: " << path << std::endl;
+        return false;
+    }
+
+    events.clear();
+    events.reserve(header.event_count);
+    size_t position = sizeof(header);
+    uint64_t frame = 0, cycle = 0;
+    for (uint32_t i = 0; i < header.event_count; ++i) {
+        uint64_t frame_delta, cycle_delta;
+        if (!read_varint(data, &position, &frame_delta) || !read_varint(data, &position, &cycle_delta)
+            || position >= data.size()) {
+            std::cerr << "ERRO: Gravacao de entrada truncada: " << path << std::endl;
+            return false;
+        }
+        frame += frame_delta;
+        cycle += cycle_delta;
+        uint8_t key = data[position++];
+        events.push_back({frame, cycle, (uint8_t)(key & 0xF), (key & RECORDED_KEY_PRESSED) != 0});
+    }
+
+    machine = header.machine;
+    seed = header.seed;
+    clock_hz = header.clock_hz;
+    frames = header.frames;
+    cycles = header.cycles;
+    framebuffer_hash = header.framebuffer_hash;
+    return true;
+}
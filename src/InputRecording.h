@@ -0,0 +1,35 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <cstdint>
+#include <vector>
+#include "InputScript.h"
+
+// Gravação de uma sessão para replay determinístico: semente do RNG, clock e
+// cada transição de tecla com o quadro e o ciclo da CPU em que ocorreu. O
+// resultado (quadros, ciclos e hash do framebuffer final) também é guardado
+// para o replay conferir que chegou à mesma tela.
+//
+// Arquivo: cabeçalho de 48 bytes ("C8IR") seguido dos eventos, cada um como
+// varint(delta de quadro), varint(delta de ciclo) e um byte (tecla | 0x10 se
+// pressionada): em geral 3 a 5 bytes por evento.
+class InputRecording {
+public:
+    InputRecording() : machine(0), seed(0), clock_hz(0), frames(0), cycles(0), framebuffer_hash(0) {}
+
+    void record(uint64_t frame, uint64_t cycle, uint8_t key, bool pressed) {
+        events.push_back({frame, cycle, (uint8_t)(key & 0xF), pressed});
+    }
+    bool save(const char* path) const;   // Erros em std::cerr
+    bool load(const char* path);
+
+    uint8_t machine;           // MachineProfile da sessão
+    uint32_t seed;
+    uint32_t clock_hz;
+    uint64_t frames;           // Quadros emulados até o fim da gravação
+    uint64_t cycles;           // Ciclos executados até o fim da gravação
+    uint64_t framebuffer_hash; // hash_framebuffer() no fim da gravação
+    std::vector<InputEvent> events; // Ordenados por (quadro, ciclo)
+};
+
+#endif // INPUTRECORDING_H
@@ -0,0 +1,47 @@
+#include "InputScript.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool InputScript::load(const std::string& script_path) {
+    std::ifstream file(script_path);
+    if (!file.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel abrir o roteiro de entrada: " << script_path << std::endl;
+        return false;
+    }
+
+    path = script_path;
+    events.clear();
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        // Linhas vazias, só com espaços ou comentários
+        const size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        std::istringstream fields(line);
+        uint64_t frame = 0;
+        std::string key_text, action;
+        unsigned long key = 16;
+        if (fields >> frame >> key_text >> action) {
+            try {
+                key = std::stoul(key_text, nullptr, 16);
+            } catch (const std::exception&) {
+                key = 16;
+            }
+        }
+        if (key > 0xF || (action != "down" && action != "up")) {
+            std::cerr << "ERRO: Roteiro de entrada invalido (" << script_path << ":" << line_number
+                      << "): '" << line << "'" << std::endl;
+            return false;
+        }
+        events.push_back({frame, 0, (uint8_t)key, action == "down"});
+    }
+
+    // Mantém a ordem do arquivo para eventos do mesmo quadro
+    std::stable_sort(events.begin(), events.end(),
+                     [](const InputEvent& a, const InputEvent& b) { return a.frame < b.frame; });
+    return true;
+}
@@ -0,0 +1,29 @@
+#ifndef INPUTSCRIPT_H
+#define INPUTSCRIPT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Roteiro de entrada para execuções sem teclado (headless / runner).
+// Formato texto, um evento por linha:  <quadro> <tecla hex 0-F> <down|up>
+// Linhas vazias ou iniciadas por '#' são ignoradas.
+struct InputEvent {
+    uint64_t frame;   // Quadro de 60Hz (tempo emulado) em que o evento é aplicado
+    uint64_t cycle;   // Ciclo da CPU (desde o início) a partir do qual se aplica (0 = início do quadro)
+    uint8_t key;      // Tecla Chip-8 (0x0 a 0xF)
+    bool pressed;
+};
+
+class InputScript {
+public:
+    bool load(const std::string& path); // false (com mensagem em std::cerr) se inválido
+    const std::vector<InputEvent>& get_events() const { return events; }
+    const std::string& get_path() const { return path; }
+
+private:
+    std::string path;
+    std::vector<InputEvent> events; // Ordenados por quadro
+};
+
+#endif // INPUTSCRIPT_H
@@ -0,0 +1,37 @@
+#include "LatencyMeter.h"
+#include <algorithm>
+#include <iomanip>
+
+void LatencyMeter::on_key_applied(uint64_t timestamp_ns, const Framebuffer& framebuffer) {
+    if (pending) return;
+    pending = true;
+    pending_timestamp_ns = timestamp_ns;
+    snapshot = framebuffer;
+}
+
+uint64_t LatencyMeter::on_frame_published(const Framebuffer& framebuffer) {
+    // A marca segue nos quadros seguintes: se a janela pular o quadro da mudança
+    // (buffer triplo), o próximo apresentado ainda fecha a medição
+    if (pending && framebuffer != snapshot) {
+        pending = false;
+        published_tag_ns = pending_timestamp_ns;
+    }
+    return published_tag_ns;
+}
+
+void LatencyMeter::on_frame_presented(uint64_t now_ns, uint64_t tag_ns) {
+    if (tag_ns == 0 || tag_ns == presented_tag_ns) return;
+    presented_tag_ns = tag_ns;
+    samples_ns.push_back(now_ns > tag_ns ? now_ns - tag_ns : 0);
+}
+
+void LatencyMeter::print_report(std::ostream& out) const {
+    if (samples_ns.empty()) return;
+    std::vector<uint64_t> sorted(samples_ns);
+    std::sort(sorted.begin(), sorted.end());
+    auto ms = [](uint64_t ns) { return (double)ns / 1e6; };
+    out << "Latencia de entrada (tecla -> tela): " << sorted.size() << " amostras, "
+        << std::fixed << std::setprecision(2)
+        << "min " << ms(sorted.front()) << " ms, mediana " << ms(sorted[sorted.size() / 2])
+        << " ms, p95 " << ms(sorted[(sorted.size() * 95) / 100]) << " ms, max " << ms(sorted.back()) << " ms" << std::endl;
+}
@@ -0,0 +1,41 @@
+#ifndef LATENCYMETER_H
+#define LATENCYMETER_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "components/Display.h"
+
+// Latência de entrada ponta a ponta: do instante em que o SO registrou a tecla
+// até a apresentação do primeiro quadro cujo framebuffer difere do que havia
+// quando a tecla foi aplicada na CPU. Uma medição por vez: teclas pressionadas
+// enquanto outra aguarda mudança na tela são ignoradas.
+//
+// Dividido entre as threads: a da CPU detecta a mudança ao publicar o quadro e
+// o marca com o instante da tecla; a da janela registra a amostra ao apresentar
+// o primeiro quadro com uma marca nova. Cada lado só toca os próprios membros.
+class LatencyMeter {
+public:
+    LatencyMeter() : pending(false), pending_timestamp_ns(0), snapshot{}, published_tag_ns(0), presented_tag_ns(0) {
+        samples_ns.reserve(1024);
+    }
+
+    // Thread da CPU
+    void on_key_applied(uint64_t timestamp_ns, const Framebuffer& framebuffer); // Apenas teclas pressionadas
+    uint64_t on_frame_published(const Framebuffer& framebuffer);                // Marca do quadro (0 = nenhuma)
+    // Thread da janela
+    void on_frame_presented(uint64_t now_ns, uint64_t tag_ns);
+
+    size_t get_sample_count() const { return samples_ns.size(); }
+    void print_report(std::ostream& out) const; // Amostras, mínimo, mediana, p95 e máximo em ms
+
+private:
+    bool pending;
+    uint64_t pending_timestamp_ns;
+    Framebuffer snapshot;
+    uint64_t published_tag_ns;  // Última mudança detectada (repetida nos quadros seguintes)
+    uint64_t presented_tag_ns;  // Última marca já medida pela janela
+    std::vector<uint64_t> samples_ns;
+};
+
+#endif // LATENCYMETER_H
@@ -0,0 +1,171 @@
+#include "Log.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+constexpr uint32_t LOG_RING_CAPACITY = 4096; // Potência de 2
+constexpr uint32_t LOG_MESSAGE_SIZE = 120;
+constexpr auto LOG_DRAIN_INTERVAL = std::chrono::milliseconds(5);
+
+static const char* const LEVEL_PREFIX[] = {"TRACE", "DEBUG", "INFO", "AVISO", "ERRO", ""};
+static const char* const LEVEL_NAME[] = {"trace", "debug", "info", "warn", "error", "off"};
+
+static std::atomic<uint8_t> runtime_level{(uint8_t)LogLevel::Info};
+
+// Ring limitado de vários produtores / um consumidor: cada posição tem um número
+// de sequência que indica se está livre para o produtor da volta atual ou pronta
+// para o consumidor.
+struct LogSlot {
+    std::atomic<uint64_t> sequence;
+    LogLevel level;
+    char text[LOG_MESSAGE_SIZE];
+};
+
+class LogRing {
+public:
+    LogRing() : tail(0), head(0), dropped(0), running(true) {
+        for (uint32_t i = 0; i < LOG_RING_CAPACITY; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        drainer = std::thread(&LogRing::drain_loop, this);
+    }
+
+    ~LogRing() {
+        // Saída do processo (inclusive via exit()): escreve o que ainda está no ring
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake.notify_one();
+        drainer.join();
+    }
+
+    void push(LogLevel level, const char* format, va_list args) {
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        LogSlot* slot;
+        while (true) {
+            slot = &slots[position & (LOG_RING_CAPACITY - 1)];
+            uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            int64_t diff = (int64_t)(sequence - position);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed); // Ring cheio
+                return;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        slot->level = level;
+        vsnprintf(slot->text, LOG_MESSAGE_SIZE, format, args);
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    void flush() {
+        // Espera o consumidor alcançar tudo que já foi publicado
+        uint64_t target = tail.load(std::memory_order_acquire);
+        wake.notify_one();
+        while (head.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    uint64_t get_dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    bool drain_one() {
+        uint64_t position = head.load(std::memory_order_relaxed);
+        LogSlot& slot = slots[position & (LOG_RING_CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) return false;
+
+        FILE* out = slot.level >= LogLevel::Warn ? stderr : stdout;
+        fprintf(out, "%s: %s\n", LEVEL_PREFIX[(int)slot.level], slot.text);
+
+        slot.sequence.store(position + LOG_RING_CAPACITY, std::memory_order_release);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    void drain_loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            lock.unlock();
+            bool wrote = false;
+            while (drain_one()) wrote = true;
+            if (wrote) {
+                fflush(stdout);
+                fflush(stderr);
+            }
+            lock.lock();
+            if (!running) break;
+            // Os produtores não notificam (evita syscalls no caminho da CPU): varredura periódica
+            wake.wait_for(lock, LOG_DRAIN_INTERVAL);
+        }
+        lock.unlock();
+        while (drain_one()) {}
+        uint64_t lost = dropped.load(std::memory_order_relaxed);
+        if (lost != 0) {
+            fprintf(stderr, "AVISO: %llu mensagens de log descartadas (ring cheio).\n", (unsigned long long)lost);
+        }
+        fflush(stdout);
+        fflush(stderr);
+    }
+
+    LogSlot slots[LOG_RING_CAPACITY];
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint64_t> head;
+    std::atomic<uint64_t> dropped;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool running;
+    std::thread drainer;
+};
+
+// Criado na primeira mensagem; a thread de fundo só existe se algo for logado
+static LogRing& ring() {
+    static LogRing instance;
+    return instance;
+}
+
+void Log::set_level(LogLevel level) {
+    runtime_level.store((uint8_t)level, std::memory_order_relaxed);
+}
+
+LogLevel Log::get_level() {
+    return (LogLevel)runtime_level.load(std::memory_order_relaxed);
+}
+
+bool Log::parse_level(const char* name, LogLevel* level) {
+    for (int i = 0; i <= (int)LogLevel::Off; ++i) {
+        if (std::strcmp(name, LEVEL_NAME[i]) == 0) {
+            *level = (LogLevel)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Log::is_enabled(LogLevel level) {
+    return (uint8_t)level >= runtime_level.load(std::memory_order_relaxed) && level != LogLevel::Off;
+}
+
+void Log::write(LogLevel level, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    ring().push(level, format, args);
+    va_end(args);
+}
+
+void Log::flush() {
+    ring().flush();
+}
+
+uint64_t Log::get_dropped() {
+    return ring().get_dropped();
+}
@@ -0,0 +1,51 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <cstdint>
+
+// Níveis de log (ordem crescente de severidade)
+enum class LogLevel : uint8_t {
+    Trace = 0, // Por instrução (despacho, handlers)
+    Debug = 1, // Eventos pontuais: inicialização, teclas, áudio
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+// Nível mínimo compilado: chamadas abaixo dele somem do binário (os argumentos
+// nem são avaliados). Definido pelo CMake (-DCHIP8_LOG_LEVEL=0 habilita TRACE).
+#ifndef CHIP8_LOG_LEVEL
+#define CHIP8_LOG_LEVEL 2
+#endif
+
+// Logger assíncrono: a mensagem é formatada direto em uma posição de um ring
+// buffer sem locks (vários produtores, um consumidor) e uma thread de fundo a
+// escreve em stdout (TRACE..INFO) ou stderr (WARN/ERROR). Com o ring cheio a
+// mensagem é descartada e contada; a CPU emulada nunca espera pelo log.
+class Log {
+public:
+    static void set_level(LogLevel level);  // Nível em tempo de execução (padrão: Info)
+    static LogLevel get_level();
+    static bool parse_level(const char* name, LogLevel* level); // trace|debug|info|warn|error|off
+
+    static bool is_enabled(LogLevel level);
+    static void write(LogLevel level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+    static void flush();                     // Aguarda a thread de fundo esvaziar o ring
+    static uint64_t get_dropped();           // Mensagens descartadas por ring cheio
+};
+
+#define CHIP8_LOG(level_value, level, ...)                                      \
+    do {                                                                        \
+        if constexpr ((level_value) >= CHIP8_LOG_LEVEL) {                       \
+            if (Log::is_enabled(level)) Log::write(level, __VA_ARGS__);         \
+        }                                                                       \
+    } while (0)
+
+#define LOG_TRACE(...) CHIP8_LOG(0, LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(...) CHIP8_LOG(1, LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  CHIP8_LOG(2, LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  CHIP8_LOG(3, LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) CHIP8_LOG(4, LogLevel::Error, __VA_ARGS__)
+
+#endif // LOG_H
@@ -0,0 +1,125 @@
+#include "Profiler.h"
+#include "Disassembler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+const char* const PROFILE_CLASS_NAMES[PROFILE_CLASS_COUNT] = {
+    "00E0", "00EE", "0NNN", "1NNN", "2NNN",
+    "3XNN", "4XNN", "5XY0", "6XNN", "7XNN",
+    "8XY0", "8XY1", "8XY2", "8XY3", "8XY4",
+    "8XY5", "8XY6", "8XY7", "8XYE", "9XY0",
+    "ANNN", "BNNN", "CXNN", "DXYN", "EX9E", "EXA1",
+    "FX07", "FX0A", "FX15", "FX18", "FX1E",
+    "FX29", "FX33", "FX55", "FX65", "????"
+};
+
+Profiler::Profiler()
+    : pc_counts{}, pc_opcodes{}, class_counts{},
+      cpu_ns(0), render_ns(0), timer_ns(0), render_calls(0), timer_calls(0) {}
+
+uint64_t Profiler::get_total() const {
+    return std::accumulate(class_counts.begin(), class_counts.end(), (uint64_t)0);
+}
+
+static double percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * (double)part / (double)total : 0.0;
+}
+
+void Profiler::print_report(std::ostream& out, size_t top_n) const {
+    const uint64_t total = get_total();
+    out << std::setfill(' ') << std::dec << "Instrucoes perfiladas: " << total << std::endl;
+
+    // Classes em ordem decrescente (apenas as executadas)
+    std::vector<int> classes;
+    for (int c = 0; c < PROFILE_CLASS_COUNT; ++c) {
+        if (class_counts[c]) classes.push_back(c);
+    }
+    std::stable_sort(classes.begin(), classes.end(),
+                     [this](int a, int b) { return class_counts[a] > class_counts[b]; });
+    out << "\nPor classe de opcode:" << std::endl;
+    out << std::left << std::setw(8) << "Classe" << std::right << std::setw(16) << "Execucoes"
+        << std::setw(9) << "%" << std::endl;
+    for (int c : classes) {
+        out << std::left << std::setw(8) << PROFILE_CLASS_NAMES[c] << std::right << std::setw(16) << class_counts[c]
+            << std::setw(8) << std::fixed << std::setprecision(2) << percent(class_counts[c], total) << '%' << std::endl;
+    }
+
+    // Endereços mais executados, com o mnemônico do último opcode visto
+    std::vector<uint16_t> addresses;
+    for (uint16_t pc = 0; pc < 4096; ++pc) {
+        if (pc_counts[pc]) addresses.push_back(pc);
+    }
+    size_t shown = std::min(top_n, addresses.size());
+    std::partial_sort(addresses.begin(), addresses.begin() + shown, addresses.end(),
+                      [this](uint16_t a, uint16_t b) {
+                          return pc_counts[a] != pc_counts[b] ? pc_counts[a] > pc_counts[b] : a < b;
+                      });
+    out << "\nTop " << shown << " enderecos (" << addresses.size() << " executados):" << std::endl;
+    out << std::left << std::setw(8) << "PC" << std::setw(8) << "Opcode" << std::setw(20) << "Instrucao"
+        << std::right << std::setw(16) << "Execucoes" << std::setw(9) << "%" << std::endl;
+    for (size_t i = 0; i < shown; ++i) {
+        uint16_t pc = addresses[i];
+        std::ostringstream address, opcode;
+        address << "0x" << std::hex << std::uppercase << std::setw(3) << std::setfill('0') << pc;
+        opcode << std::hex << std::uppercase << std::setw(4) << std::setfill('0') << pc_opcodes[pc];
+        out << std::left << std::setw(8) << address.str() << std::setw(8) << opcode.str()
+            << std::setw(20) << disassemble(pc_opcodes[pc]) << std::right << std::setw(16) << pc_counts[pc]
+            << std::setw(8) << std::fixed << std::setprecision(2) << percent(pc_counts[pc], total) << '%' << std::endl;
+    }
+
+    // Tempo por etapa do laço principal
+    const uint64_t measured = cpu_ns + render_ns + timer_ns;
+    out << "\nTempo medido:" << std::endl;
+    out << "  CPU:    " << std::setw(10) << std::setprecision(3) << cpu_ns / 1e6 << " ms ("
+        << std::setprecision(1) << percent(cpu_ns, measured) << "%)" << std::endl;
+    out << "  Render: " << std::setw(10) << std::setprecision(3) << render_ns / 1e6 << " ms ("
+        << std::setprecision(1) << percent(render_ns, measured) << "%, " << render_calls << " chamadas)" << std::endl;
+    out << "  Timers: " << std::setw(10) << std::setprecision(3) << timer_ns / 1e6 << " ms ("
+        << std::setprecision(1) << percent(timer_ns, measured) << "%, " << timer_calls << " chamadas)" << std::endl;
+    if (total && cpu_ns) {
+        out << "  ns/instrucao (com contadores): " << std::setprecision(2) << (double)cpu_ns / (double)total << std::endl;
+    }
+}
+
+bool Profiler::write_heatmap(const char* path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel gravar o perfil em " << path << std::endl;
+        return false;
+    }
+    std::string name(path);
+    bool json = name.size() >= 5 && name.compare(name.size() - 5, 5, ".json") == 0;
+    return json ? write_json(file) : write_csv(file);
+}
+
+bool Profiler::write_csv(std::ostream& out) const {
+    // Uma linha por endereço (4096), zeros incluídos: pronto para plotar
+    out << "address,count,opcode,instruction\n";
+    for (uint16_t pc = 0; pc < 4096; ++pc) {
+        out << pc << ',' << pc_counts[pc] << ',';
+        if (pc_counts[pc]) out << pc_opcodes[pc] << ",\"" << disassemble(pc_opcodes[pc]) << '"';
+        else out << ',';
+        out << '\n';
+    }
+    return (bool)out;
+}
+
+bool Profiler::write_json(std::ostream& out) const {
+    out << "{\n  \"total\": " << get_total() << ",\n";
+    out << "  \"time_ns\": {\"cpu\": " << cpu_ns << ", \"render\": " << render_ns << ", \"timers\": " << timer_ns << "},\n";
+    out << "  \"classes\": {";
+    for (int c = 0; c < PROFILE_CLASS_COUNT; ++c) {
+        out << (c ? ", " : "") << '"' << PROFILE_CLASS_NAMES[c] << "\": " << class_counts[c];
+    }
+    out << "},\n  \"heatmap\": [";
+    for (uint16_t pc = 0; pc < 4096; ++pc) {
+        out << (pc ? (pc % 32 ? "," : ",\n    ") : "\n    ") << pc_counts[pc];
+    }
+    out << "\n  ]\n}\n";
+    return (bool)out;
+}
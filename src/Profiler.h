@@ -0,0 +1,103 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Classes de opcode contadas pelo profiler (uma por instrução do CHIP-8)
+enum ProfileClass : uint8_t {
+    PROFILE_CLS, PROFILE_RET, PROFILE_SYS, PROFILE_JP, PROFILE_CALL,
+    PROFILE_SE_BYTE, PROFILE_SNE_BYTE, PROFILE_SE_REG, PROFILE_LD_BYTE, PROFILE_ADD_BYTE,
+    PROFILE_LD_REG, PROFILE_OR, PROFILE_AND, PROFILE_XOR, PROFILE_ADD_REG,
+    PROFILE_SUB, PROFILE_SHR, PROFILE_SUBN, PROFILE_SHL, PROFILE_SNE_REG,
+    PROFILE_LD_I, PROFILE_JP_V0, PROFILE_RND, PROFILE_DRW, PROFILE_SKP, PROFILE_SKNP,
+    PROFILE_LD_VX_DT, PROFILE_LD_KEY, PROFILE_LD_DT, PROFILE_LD_ST, PROFILE_ADD_I,
+    PROFILE_LD_FONT, PROFILE_LD_BCD, PROFILE_STORE_REGS, PROFILE_LOAD_REGS, PROFILE_UNKNOWN,
+    PROFILE_CLASS_COUNT
+};
+
+// Padrão de cada classe (ex.: "8XY4", "DXYN")
+extern const char* const PROFILE_CLASS_NAMES[PROFILE_CLASS_COUNT];
+
+constexpr size_t DEFAULT_PROFILE_TOP = 20; // Linhas da tabela de endereços mais executados
+
+// Profiler do caminho quente: contadores em arrays planos pré-alocados (por
+// endereço e por classe de opcode), incrementados pelo laço do interpretador
+// sem alocação nem desvio extra. Também acumula o tempo de CPU, render e
+// timers medido pelos wrappers de Chip8.
+class Profiler {
+public:
+    Profiler();
+
+    void count(uint16_t pc, uint16_t opcode) {
+        ++pc_counts[pc];
+        pc_opcodes[pc] = opcode; // Último opcode visto no endereço (código automodificável)
+        ++class_counts[classify(opcode)];
+    }
+    void add_cpu_time(uint64_t ns) { cpu_ns += ns; }
+    void add_render_time(uint64_t ns) { render_ns += ns; ++render_calls; }
+    void add_timer_time(uint64_t ns) { timer_ns += ns; ++timer_calls; }
+
+    static ProfileClass classify(uint16_t opcode) {
+        // Grupos de instrução única pelo nibble alto; 0, 8, E e F pelo nibble/byte baixo
+        static const ProfileClass GROUPS[16] = {
+            PROFILE_SYS, PROFILE_JP, PROFILE_CALL, PROFILE_SE_BYTE, PROFILE_SNE_BYTE, PROFILE_SE_REG,
+            PROFILE_LD_BYTE, PROFILE_ADD_BYTE, PROFILE_UNKNOWN, PROFILE_SNE_REG, PROFILE_LD_I,
+            PROFILE_JP_V0, PROFILE_RND, PROFILE_DRW, PROFILE_UNKNOWN, PROFILE_UNKNOWN
+        };
+        static const ProfileClass ALU[16] = {
+            PROFILE_LD_REG, PROFILE_OR, PROFILE_AND, PROFILE_XOR, PROFILE_ADD_REG, PROFILE_SUB,
+            PROFILE_SHR, PROFILE_SUBN, PROFILE_UNKNOWN, PROFILE_UNKNOWN, PROFILE_UNKNOWN,
+            PROFILE_UNKNOWN, PROFILE_UNKNOWN, PROFILE_UNKNOWN, PROFILE_SHL, PROFILE_UNKNOWN
+        };
+        const uint8_t nn = opcode & 0xFF;
+        switch (opcode >> 12) {
+            case 0x0: return opcode == 0x00E0 ? PROFILE_CLS : opcode == 0x00EE ? PROFILE_RET : PROFILE_SYS;
+            case 0x5: case 0x9: return (opcode & 0xF) == 0 ? GROUPS[opcode >> 12] : PROFILE_UNKNOWN;
+            case 0x8: return ALU[opcode & 0xF];
+            case 0xE: return nn == 0x9E ? PROFILE_SKP : nn == 0xA1 ? PROFILE_SKNP : PROFILE_UNKNOWN;
+            case 0xF:
+                switch (nn) {
+                    case 0x07: return PROFILE_LD_VX_DT;
+                    case 0x0A: return PROFILE_LD_KEY;
+                    case 0x15: return PROFILE_LD_DT;
+                    case 0x18: return PROFILE_LD_ST;
+                    case 0x1E: return PROFILE_ADD_I;
+                    case 0x29: return PROFILE_LD_FONT;
+                    case 0x33: return PROFILE_LD_BCD;
+                    case 0x55: return PROFILE_STORE_REGS;
+                    case 0x65: return PROFILE_LOAD_REGS;
+                    case 0x9E: return PROFILE_SKP; // Mesmo mapeamento do decodificador
+                    case 0xA1: return PROFILE_SKNP;
+                    default: return PROFILE_UNKNOWN;
+                }
+            default: return GROUPS[opcode >> 12];
+        }
+    }
+
+    uint64_t get_total() const;
+    uint64_t get_pc_count(uint16_t pc) const { return pc_counts[pc & 0xFFF]; }
+    uint64_t get_class_count(ProfileClass profile_class) const { return class_counts[profile_class]; }
+
+    // Tabelas com as classes e os top_n endereços mais executados, mais os tempos
+    void print_report(std::ostream& out, size_t top_n) const;
+    // Mapa de calor dos 4 KB: JSON se o caminho terminar em .json, senão CSV
+    bool write_heatmap(const char* path) const;
+
+private:
+    bool write_csv(std::ostream& out) const;
+    bool write_json(std::ostream& out) const;
+
+    std::array<uint64_t, 4096> pc_counts;
+    std::array<uint16_t, 4096> pc_opcodes;
+    std::array<uint64_t, PROFILE_CLASS_COUNT> class_counts;
+    uint64_t cpu_ns;
+    uint64_t render_ns;
+    uint64_t timer_ns;
+    uint64_t render_calls;
+    uint64_t timer_calls;
+};
+
+#endif // PROFILER_H
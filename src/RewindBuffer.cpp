@@ -0,0 +1,179 @@
+#include "RewindBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+// Base dos keyframes: o RLE de (estado XOR zero) é o próprio estado
+static const uint8_t ZERO_STATE[sizeof(SaveState)] = {};
+
+// Um trecho literal só termina em uma sequência de bytes iguais deste tamanho:
+// pausas menores custariam mais em cabeçalho do que economizam
+constexpr uint32_t MIN_ZERO_RUN = 4;
+
+static inline bool same_word(const uint8_t* a, const uint8_t* b) {
+    uint64_t x, y;
+    std::memcpy(&x, a, 8);
+    std::memcpy(&y, b, 8);
+    return x == y;
+}
+
+static size_t write_varint(uint8_t* out, size_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+static size_t read_varint(const uint8_t* data, size_t* value) {
+    size_t length = 0;
+    uint32_t shift = 0;
+    *value = 0;
+    do {
+        *value |= (size_t)(data[length] & 0x7F) << shift;
+        shift += 7;
+    } while (data[length++] & 0x80);
+    return length;
+}
+
+RewindBuffer::RewindBuffer(size_t capacity_bytes, uint32_t keyframe_interval)
+    : arena(std::max(capacity_bytes, 4 * sizeof(SaveState))),
+      write_pos(0),
+      keyframe_interval(keyframe_interval ? keyframe_interval : 1),
+      frames_since_keyframe(0),
+      last{},
+      scratch(2 * sizeof(SaveState))
+{
+}
+
+void RewindBuffer::clear() {
+    entries.clear();
+    write_pos = 0;
+    frames_since_keyframe = 0;
+}
+
+size_t RewindBuffer::encode(const uint8_t* current, const uint8_t* base, size_t size, uint8_t* out) {
+    size_t out_size = 0;
+    size_t i = 0;
+    while (i < size) {
+        // Trecho sem mudança (palavras de 8 bytes enquanto possível)
+        size_t zero_start = i;
+        while (i + 8 <= size && same_word(current + i, base + i)) i += 8;
+        while (i < size && current[i] == base[i]) ++i;
+        size_t zeros = i - zero_start;
+
+        // Trecho alterado, até MIN_ZERO_RUN bytes iguais seguidos
+        size_t literal_start = i;
+        uint32_t equal_run = 0;
+        while (i < size) {
+            if (current[i] == base[i]) {
+                if (++equal_run == MIN_ZERO_RUN) {
+                    i -= MIN_ZERO_RUN - 1;
+                    break;
+                }
+            } else {
+                equal_run = 0;
+            }
+            ++i;
+        }
+        size_t literals = i - literal_start;
+        if (literals == 0) break; // Zeros até o fim: nada a gravar
+
+        out_size += write_varint(out + out_size, zeros);
+        out_size += write_varint(out + out_size, literals);
+        for (size_t k = 0; k < literals; ++k) {
+            out[out_size++] = current[literal_start + k] ^ base[literal_start + k];
+        }
+    }
+    return out_size;
+}
+
+void RewindBuffer::apply(const uint8_t* data, size_t size, uint8_t* state) {
+    size_t read = 0;
+    size_t position = 0;
+    while (read < size) {
+        size_t zeros, literals;
+        read += read_varint(data + read, &zeros);
+        read += read_varint(data + read, &literals);
+        position += zeros;
+        for (size_t k = 0; k < literals; ++k) {
+            state[position++] ^= data[read++];
+        }
+    }
+}
+
+uint32_t RewindBuffer::allocate(uint32_t size) {
+    if (write_pos + size > arena.size()) {
+        // Volta ao início: o que restou no fim da arena são os quadros mais antigos
+        while (!entries.empty() && entries.front().offset >= write_pos) entries.pop_front();
+        write_pos = 0;
+    }
+    // Descarta os mais antigos que ocupam a região a ser escrita...
+    while (!entries.empty() && entries.front().offset < write_pos + size
+           && write_pos < entries.front().offset + entries.front().size) {
+        entries.pop_front();
+    }
+    // ...e os deltas que ficaram sem o seu keyframe
+    while (!entries.empty() && !entries.front().keyframe) entries.pop_front();
+
+    uint32_t offset = write_pos;
+    write_pos += size;
+    return offset;
+}
+
+void RewindBuffer::push(const SaveState& state) {
+    // Só os bytes usados pela máquina (state.size): o clássico codifica ~4,4 KB por quadro
+    const uint8_t* current = (const uint8_t*)&state;
+    const size_t state_size = std::min<size_t>(state.size, sizeof(SaveState));
+    bool keyframe = entries.empty() || frames_since_keyframe + 1 >= keyframe_interval || last.size != state.size;
+    size_t size = encode(current, keyframe ? ZERO_STATE : (const uint8_t*)&last, state_size, scratch.data());
+    uint32_t offset = allocate((uint32_t)size);
+    if (!keyframe && entries.empty()) {
+        // A base do delta foi descartada para abrir espaço: grava um keyframe
+        keyframe = true;
+        write_pos = offset;
+        size = encode(current, ZERO_STATE, state_size, scratch.data());
+        offset = allocate((uint32_t)size);
+    }
+    std::memcpy(arena.data() + offset, scratch.data(), size);
+    entries.push_back({offset, (uint32_t)size, keyframe});
+    frames_since_keyframe = keyframe ? 0 : frames_since_keyframe + 1;
+    std::memcpy(&last, &state, state_size);
+}
+
+void RewindBuffer::decode(size_t index, SaveState& out) const {
+    size_t keyframe = index;
+    while (!entries[keyframe].keyframe) --keyframe; // O mais antigo é sempre keyframe
+    std::memset(&out, 0, sizeof(out));
+    for (size_t i = keyframe; i <= index; ++i) {
+        apply(arena.data() + entries[i].offset, entries[i].size, (uint8_t*)&out);
+    }
+}
+
+bool RewindBuffer::peek(uint32_t frames_back, SaveState& out) const {
+    if (frames_back >= entries.size()) return false;
+    decode(entries.size() - 1 - frames_back, out);
+    return true;
+}
+
+bool RewindBuffer::step_back(uint32_t frames, SaveState& out) {
+    if (entries.empty()) return false;
+    frames = std::min(frames, (uint32_t)entries.size() - 1);
+    for (uint32_t i = 0; i < frames; ++i) entries.pop_back();
+
+    const Entry& newest = entries.back();
+    write_pos = newest.offset + newest.size;
+    frames_since_keyframe = 0;
+    for (size_t i = entries.size() - 1; !entries[i].keyframe; --i) ++frames_since_keyframe;
+
+    decode(entries.size() - 1, out);
+    last = out;
+    return true;
+}
+
+size_t RewindBuffer::get_used_bytes() const {
+    size_t used = 0;
+    for (const Entry& entry : entries) used += entry.size;
+    return used;
+}
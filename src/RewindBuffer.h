@@ -0,0 +1,60 @@
+#ifndef REWINDBUFFER_H
+#define REWINDBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "SaveState.h"
+
+constexpr size_t DEFAULT_REWIND_BYTES = 512 * 1024;
+constexpr uint32_t DEFAULT_REWIND_KEYFRAME_INTERVAL = 60; // Um keyframe por segundo emulado
+
+// Histórico de save states (um por quadro) para voltar no tempo.
+//
+// Cada quadro é guardado compactado em uma arena circular de bytes de tamanho
+// fixo: a cada N quadros um keyframe (o SaveState inteiro em RLE) e, entre eles,
+// deltas (XOR com o quadro anterior em RLE: só os bytes que mudaram ocupam
+// espaço). Com a arena cheia, os quadros mais antigos são descartados em grupos
+// inteiros de keyframe + deltas. Restaurar decodifica o keyframe e aplica no
+// máximo N-1 deltas.
+class RewindBuffer {
+public:
+    RewindBuffer(size_t capacity_bytes, uint32_t keyframe_interval);
+
+    void push(const SaveState& state);   // Chamado ao fim de cada quadro emulado
+    void clear();
+
+    // Decodifica o quadro frames_back quadros antes do mais novo (0 = mais novo)
+    bool peek(uint32_t frames_back, SaveState& out) const;
+    // Volta frames quadros: descarta os mais novos e decodifica o novo topo
+    // (o histórico continua a partir dele). Mantém sempre ao menos um quadro.
+    bool step_back(uint32_t frames, SaveState& out);
+
+    uint32_t get_frame_count() const { return (uint32_t)entries.size(); }
+    size_t get_used_bytes() const;
+    size_t get_capacity_bytes() const { return arena.size(); }
+
+private:
+    struct Entry {
+        uint32_t offset; // Posição na arena
+        uint32_t size;   // Bytes codificados
+        bool keyframe;
+    };
+
+    // RLE da diferença XOR: pares (zeros, literais) em varint seguidos dos literais
+    static size_t encode(const uint8_t* current, const uint8_t* base, size_t size, uint8_t* out);
+    static void apply(const uint8_t* data, size_t size, uint8_t* state);
+    uint32_t allocate(uint32_t size);
+    void decode(size_t index, SaveState& out) const;
+
+    std::vector<uint8_t> arena;
+    std::deque<Entry> entries;            // Do mais antigo ao mais novo
+    uint32_t write_pos;
+    uint32_t keyframe_interval;
+    uint32_t frames_since_keyframe;
+    SaveState last;                       // Base do próximo delta
+    std::vector<uint8_t> scratch;         // Quadro codificado antes de ir para a arena
+};
+
+#endif // REWINDBUFFER_H
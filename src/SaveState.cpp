@@ -0,0 +1,76 @@
+#include "SaveState.h"
+#include "Chip8.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+size_t save_state_framebuffer_size(uint8_t machine) {
+    switch ((MachineProfile)machine) {
+        case MachineProfile::Chip8:     return CHIP8_HEIGHT * 8;                                 // Palavra 0 das linhas 0..31
+        case MachineProfile::SuperChip: return HIRES_HEIGHT * FRAMEBUFFER_ROW_WORDS * 8;          // Plano 0
+        case MachineProfile::XoChip:    return 2 * HIRES_HEIGHT * FRAMEBUFFER_ROW_WORDS * 8;      // Dois planos
+    }
+    return 0;
+}
+
+size_t save_state_size(uint8_t machine) {
+    if (machine > (uint8_t)MachineProfile::XoChip) return 0;
+    const size_t memory = (MachineProfile)machine == MachineProfile::XoChip ? 65536 : 4096;
+    return SAVE_STATE_DATA_OFFSET + save_state_framebuffer_size(machine) + memory;
+}
+
+uint64_t save_state_checksum(const SaveState& state) {
+    // FNV-1a sobre palavras de 64 bits, com mistura final para espalhar os bits altos
+    const uint8_t* bytes = (const uint8_t*)&state + SAVE_STATE_HEADER_SIZE;
+    const size_t words = (std::min<size_t>(state.size, sizeof(SaveState)) - SAVE_STATE_HEADER_SIZE) / 8;
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i * 8, 8);
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+    hash ^= hash >> 29;
+    return hash;
+}
+
+bool is_valid_save_state(const SaveState& state) {
+    return std::memcmp(state.magic, "C8SS", 4) == 0
+        && state.version == SAVE_STATE_VERSION
+        && state.machine <= (uint8_t)MachineProfile::XoChip
+        && state.size == save_state_size(state.machine)
+        && state.checksum == save_state_checksum(state);
+}
+
+bool write_save_state(const char* path, const SaveState& state) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        std::cerr << "ERRO: Nao foi possivel criar o save state: " << path << std::endl;
+        return false;
+    }
+    bool ok = state.size <= sizeof(state) && std::fwrite(&state, state.size, 1, file) == 1;
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) std::cerr << "ERRO: Falha ao gravar o save state: " << path << std::endl;
+    return ok;
+}
+
+bool read_save_state(const char* path, SaveState& state) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        std::cerr << "ERRO: Nao foi possivel abrir o save state: " << path << std::endl;
+        return false;
+    }
+    // Cabeçalho primeiro (o tamanho depende da máquina); um byte a mais no final
+    // indica arquivo de outro formato/versão
+    char extra;
+    bool ok = std::fread(&state, SAVE_STATE_HEADER_SIZE, 1, file) == 1
+        && state.size > SAVE_STATE_HEADER_SIZE && state.size <= sizeof(state)
+        && std::fread((uint8_t*)&state + SAVE_STATE_HEADER_SIZE, state.size - SAVE_STATE_HEADER_SIZE, 1, file) == 1
+        && std::fread(&extra, 1, 1, file) == 0;
+    std::fclose(file);
+    if (!ok || !is_valid_save_state(state)) {
+        std::cerr << "ERRO: Save state invalido ou corrompido: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
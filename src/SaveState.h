@@ -0,0 +1,70 @@
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include "components/Display.h"
+
+// Snapshot completo da máquina em um bloco sem ponteiros nem alocação: pode ser
+// copiado com memcpy, guardado em arrays ou gravado direto em disco. Campos na
+// ordem do host (little-endian em x86/ARM). Só os primeiros `size` bytes são
+// usados: data[] guarda apenas o framebuffer e a memória que a máquina tem, de
+// modo que o CHIP-8 clássico ocupa 4480 bytes (SUPER-CHIP 5248, XO-CHIP 67712).
+// O checksum cobre tudo o que vem depois do cabeçalho, até `size`.
+struct SaveState {
+    // --- Cabeçalho (24 bytes) ---
+    char magic[4];          // "C8SS"
+    uint16_t version;
+    uint8_t machine;        // MachineProfile
+    uint8_t reserved_header;
+    uint32_t size;          // Bytes usados: save_state_size(machine)
+    uint32_t reserved_size;
+    uint64_t checksum;      // save_state_checksum() do payload
+
+    // --- Payload: registradores (104 bytes) ---
+    uint32_t rng_state;     // xorshift32 de CXNN
+    uint16_t I;
+    uint16_t PC;
+    uint16_t stack[16];
+    uint16_t key_state;     // Bit k = tecla k pressionada
+    uint8_t V[16];
+    uint8_t SP;
+    uint8_t delay_timer;
+    uint8_t sound_timer;
+    uint8_t waiting_for_key; // FX0A pendente (PC aponta para o FX0A)
+    uint8_t key_register;    // X do FX0A pendente
+    uint8_t plane_mask;      // Planos selecionados por FN01
+    uint8_t audio_pitch;     // Fx3A
+    uint8_t hires;           // Framebuffer em 128x64
+    uint8_t rpl[16];         // Flags RPL (Fx75/Fx85)
+    uint8_t audio_pattern[16]; // F002
+    uint8_t reserved_payload[6]; // Zero (mantém data alinhada a 8 bytes)
+
+    // --- Payload: framebuffer e memória da máquina ---
+    // Linhas dos planos usados (clássico: 32 palavras de 64 bits; SUPER-CHIP:
+    // plano 0 inteiro; XO-CHIP: os dois planos), seguidas de memory_size() bytes
+    uint8_t data[2 * HIRES_HEIGHT * FRAMEBUFFER_ROW_WORDS * 8 + 65536];
+};
+static_assert(sizeof(SaveState) == 67712, "SaveState deve ter 67712 bytes (sem padding implícito)");
+
+constexpr uint16_t SAVE_STATE_VERSION = 3;
+constexpr size_t SAVE_STATE_HEADER_SIZE = 24;
+constexpr size_t SAVE_STATE_DATA_OFFSET = 128; // Cabeçalho + registradores
+static_assert(offsetof(SaveState, data) == SAVE_STATE_DATA_OFFSET, "data deve vir logo após os registradores");
+
+// Bytes do framebuffer em data[] e tamanho total usado por cada máquina (0 se inválida)
+size_t save_state_framebuffer_size(uint8_t machine);
+size_t save_state_size(uint8_t machine);
+
+// Hash de 64 bits do payload, palavra a palavra (~560 multiplicações no clássico)
+uint64_t save_state_checksum(const SaveState& state);
+
+// Confere magic, versão, máquina, tamanho e checksum
+bool is_valid_save_state(const SaveState& state);
+
+// Arquivo = os `size` primeiros bytes do bloco. Erros vão para std::cerr.
+bool write_save_state(const char* path, const SaveState& state);
+bool read_save_state(const char* path, SaveState& state);
+
+#endif // SAVESTATE_H
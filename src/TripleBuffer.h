@@ -0,0 +1,41 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Buffer triplo sem locks entre um escritor e um leitor: o escritor preenche o
+// slot de trás e o publica trocando-o com o slot do meio; o leitor pega o slot
+// do meio (se houver um novo) trocando-o com o da frente. Nenhum lado espera o
+// outro: o escritor nunca bloqueia e o leitor sempre vê o quadro mais recente
+// completo (quadros intermediários não lidos são descartados).
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : slots{}, back(0), front(2), middle(1) {}
+
+    // Escritor: slot a preencher e publicação
+    T& get_write_slot() { return slots[back]; }
+    void publish() {
+        back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Leitor: troca para o quadro mais recente; false se nada novo foi publicado
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T& get_read_slot() const { return slots[front]; }
+
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t FRESH = 0x4; // Slot do meio ainda não lido
+
+    T slots[3];
+    uint8_t back;                 // Só o escritor
+    uint8_t front;                // Só o leitor
+    std::atomic<uint8_t> middle;  // Índice do slot do meio | FRESH
+};
+
+#endif // TRIPLEBUFFER_H
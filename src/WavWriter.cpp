@@ -0,0 +1,89 @@
+#include "WavWriter.h"
+#include <algorithm>
+#include <iostream>
+
+constexpr uint32_t WAV_HEADER_SIZE = 44;
+constexpr uint16_t WAV_BITS_PER_SAMPLE = 16;
+
+// Campos do WAV são little-endian independentemente do host
+static void put16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t* out, uint32_t value) {
+    put16(out, (uint16_t)value);
+    put16(out + 2, (uint16_t)(value >> 16));
+}
+
+static void make_header(uint8_t* header, uint32_t sample_rate, uint32_t data_bytes) {
+    const uint16_t block_align = WAV_BITS_PER_SAMPLE / 8;
+    std::copy_n("RIFF", 4, header);
+    put32(header + 4, WAV_HEADER_SIZE - 8 + data_bytes);
+    std::copy_n("WAVEfmt ", 8, header + 8);
+    put32(header + 16, 16);                        // Tamanho do bloco fmt
+    put16(header + 20, 1);                         // PCM
+    put16(header + 22, 1);                         // Mono
+    put32(header + 24, sample_rate);
+    put32(header + 28, sample_rate * block_align); // Bytes/s
+    put16(header + 32, block_align);
+    put16(header + 34, WAV_BITS_PER_SAMPLE);
+    std::copy_n("data", 4, header + 36);
+    put32(header + 40, data_bytes);
+}
+
+WavWriter::WavWriter(Waveform waveform)
+    : beeper(waveform),
+      samples(beeper.get_max_tick_samples()),
+      pcm(beeper.get_max_tick_samples() * 2),
+      file(nullptr),
+      sample_count(0),
+      hash(0xcbf29ce484222325ULL),
+      write_failed(false)
+{}
+
+WavWriter::~WavWriter() {
+    if (file) close();
+}
+
+bool WavWriter::open(const char* path) {
+    file = std::fopen(path, "wb");
+    if (!file) {
+        std::cerr << "ERRO: Nao foi possivel criar o arquivo WAV: " << path << std::endl;
+        return false;
+    }
+    // Cabeçalho provisório: os tamanhos são gravados em close()
+    uint8_t header[WAV_HEADER_SIZE];
+    make_header(header, beeper.get_sample_rate(), 0);
+    return std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+}
+
+void WavWriter::write_tick(const BeepGate& gate) {
+    if (!file) return;
+    size_t count = beeper.render_tick(gate, samples.data());
+    for (size_t i = 0; i < count; ++i) {
+        // Conversão por truncamento: determinística em qualquer host
+        int16_t value = (int16_t)(samples[i] * 32767.0f);
+        put16(&pcm[i * 2], (uint16_t)value);
+    }
+    for (size_t i = 0; i < count * 2; ++i) {
+        hash ^= pcm[i];
+        hash *= 0x100000001b3ULL;
+    }
+    if (std::fwrite(pcm.data(), 1, count * 2, file) != count * 2) write_failed = true;
+    sample_count += count;
+}
+
+bool WavWriter::close() {
+    if (!file) return false;
+    uint8_t header[WAV_HEADER_SIZE];
+    make_header(header, beeper.get_sample_rate(), (uint32_t)(sample_count * 2));
+    // Amostras perdidas deixariam um WAV truncado com cabeçalho aparentemente válido
+    bool ok = !write_failed
+           && std::fseek(file, 0, SEEK_SET) == 0
+           && std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok) std::cerr << "ERRO: Falha ao gravar o arquivo WAV." << std::endl;
+    return ok;
+}
@@ -0,0 +1,38 @@
+#ifndef WAVWRITER_H
+#define WAVWRITER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "components/Beeper.h"
+
+// Renderização offline do bipe em um arquivo WAV (PCM 16 bits, mono, 44100 Hz),
+// sem dispositivo de áudio. Cada tick de 60Hz do modo headless gera as amostras
+// do quadro emulado pelo mesmo Beeper da janela: o arquivo segue o tempo emulado
+// (10 minutos de sessão viram 36000 ticks, renderizados em milissegundos) e é
+// determinístico, byte a byte, para a mesma execução.
+class WavWriter {
+public:
+    explicit WavWriter(Waveform waveform = Waveform::Square);
+    ~WavWriter();
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    bool open(const char* path);   // Erros em std::cerr
+    void write_tick(const BeepGate& gate); // Um quadro de 60Hz (Chip8::get_beep_gate)
+    bool close();                  // Completa o cabeçalho; false se alguma escrita falhou
+
+    uint64_t get_sample_count() const { return sample_count; }
+    uint64_t get_hash() const { return hash; } // FNV-1a das amostras PCM
+
+private:
+    Beeper beeper;
+    std::vector<float> samples;
+    std::vector<uint8_t> pcm;
+    std::FILE* file;
+    uint64_t sample_count;
+    uint64_t hash;
+    bool write_failed; // fwrite curto em write_tick (ex.: disco cheio)
+};
+
+#endif // WAVWRITER_H
@@ -0,0 +1,105 @@
+#include "aot/AotEngine.h"
+#include "Chip8.h"
+#include <algorithm>
+#include <cstring>
+
+// Programas compilados no executável (registrados por register_aot_programs)
+static std::vector<const AotProgram*>& program_registry() {
+    static std::vector<const AotProgram*> programs;
+    return programs;
+}
+
+void aot_register_program(const AotProgram* program) {
+    program_registry().push_back(program);
+}
+
+// =====================================================================
+// CONTEXTO DO CÓDIGO GERADO
+// =====================================================================
+
+void AotContext::execute(uint16_t opcode) { chip->execute_opcode(opcode); }
+uint8_t AotContext::random() { return chip->next_random(); }
+bool AotContext::key_pressed(uint8_t key) const { return chip->input.key_state[key]; }
+uint8_t AotContext::delay_timer() const { return chip->timers.get_delay_timer(); }
+
+// =====================================================================
+// MOTOR
+// =====================================================================
+
+AotEngine::AotEngine(Chip8& vm, const AotProgram& aot_program)
+    : chip(vm), program(aot_program),
+      context{vm.V, &vm.I, &vm.PC, vm.stack, &vm.SP, vm.memory.data(), &vm},
+      stale(aot_program.block_count, true),
+      native_cycles(0), fallback_cycles(0)
+{
+    block_at.fill(-1);
+    for (uint32_t i = 0; i < program.block_count; ++i) {
+        const AotBlock& block = program.blocks[i];
+        block_at[block.start & 0xFFF] = (int32_t)i;
+        for (uint32_t addr = block.start; addr < (uint32_t)block.start + block.bytes && addr < 4096; ++addr) {
+            covered.set(addr);
+        }
+    }
+}
+
+const AotProgram* AotEngine::find_program(const uint8_t* memory) {
+    for (const AotProgram* program : program_registry()) {
+        bool match = true;
+        for (uint32_t i = 0; i < program->block_count && match; ++i) {
+            const AotBlock& block = program->blocks[i];
+            match = std::memcmp(memory + block.start, program->code + block.code_offset, block.bytes) == 0;
+        }
+        if (match) return program;
+    }
+    return nullptr;
+}
+
+size_t AotEngine::program_count() {
+    return program_registry().size();
+}
+
+bool AotEngine::verify(uint32_t index) {
+    // Bytes iguais aos da tradução: o bloco volta a valer (ex.: load_state restaurou o código)
+    const AotBlock& block = program.blocks[index];
+    if (std::memcmp(context.memory + block.start, program.code + block.code_offset, block.bytes) != 0) return false;
+    stale[index] = false;
+    return true;
+}
+
+uint32_t AotEngine::run(uint32_t max_cycles) {
+    uint32_t remaining = max_cycles;
+    while (remaining > 0) {
+        const int32_t index = block_at[chip.PC & 0xFFF];
+        if (index >= 0 && remaining >= program.blocks[index].instructions && (!stale[index] || verify(index))) {
+            uint32_t executed = program.blocks[index].run(context);
+            if (executed > 0) {
+                native_cycles += executed;
+                remaining -= executed;
+                if (chip.sound_timer_written) break; // FX18 fecha o bloco: run_cycles registra o ciclo
+                continue;
+            }
+            // Nenhum progresso (RET/CALL com a pilha inválida): o interpretador reporta o erro
+        }
+        uint32_t executed = chip.interpret_cycles(1);
+        fallback_cycles += executed;
+        remaining -= executed;
+        if (chip.m_is_waiting_for_key || chip.idle_loop_hit || chip.sound_timer_written || chip.faulted) break;
+    }
+    return max_cycles - remaining;
+}
+
+void AotEngine::invalidate(uint16_t address, uint16_t length) {
+    const uint32_t lo = address;
+    const uint32_t hi = std::min<uint32_t>((uint32_t)address + length, 4096);
+    bool hit = false;
+    for (uint32_t addr = lo; addr < hi && !hit; ++addr) hit = covered[addr];
+    if (!hit) return;
+    for (uint32_t i = 0; i < program.block_count; ++i) {
+        const AotBlock& block = program.blocks[i];
+        if (block.start < hi && (uint32_t)block.start + block.bytes > lo) stale[i] = true;
+    }
+}
+
+void AotEngine::flush() {
+    std::fill(stale.begin(), stale.end(), true);
+}
@@ -0,0 +1,46 @@
+#ifndef AOTENGINE_H
+#define AOTENGINE_H
+
+#include <cstdint>
+#include <array>
+#include <bitset>
+#include <vector>
+#include "aot/AotProgram.h"
+
+// Motor de execução dos programas pré-compilados (CpuEngine::Aot). Despacha pelo
+// PC para o bloco gerado que começa nele; sem bloco (BNNN, FX0A, laços de espera,
+// código não alcançado na tradução) ou com os bytes alterados desde a tradução,
+// a instrução é executada pelo interpretador.
+class AotEngine {
+public:
+    AotEngine(Chip8& chip, const AotProgram& program);
+
+    // Primeiro programa registrado cujos blocos batem com a memória (nullptr se nenhum)
+    static const AotProgram* find_program(const uint8_t* memory);
+    static size_t program_count(); // Programas registrados (0 = build sem CHIP8_AOT_ROMS)
+
+    // Executa até max_cycles instruções (nativas ou interpretadas). Retorna as executadas.
+    uint32_t run(uint32_t max_cycles);
+
+    // Escritas de FX33/FX55: os blocos que cobrem os bytes são conferidos de novo
+    void invalidate(uint16_t address, uint16_t length);
+    void flush(); // Todos os blocos são conferidos de novo (nova ROM, load_state)
+
+    const AotProgram& get_program() const { return program; }
+    uint64_t get_native_cycles() const { return native_cycles; }
+    uint64_t get_fallback_cycles() const { return fallback_cycles; }
+
+private:
+    bool verify(uint32_t index);
+
+    Chip8& chip;
+    const AotProgram& program;
+    AotContext context;
+    std::array<int32_t, 4096> block_at; // Índice do bloco que começa no endereço (-1 = nenhum)
+    std::bitset<4096> covered;          // Bytes cobertos por algum bloco
+    std::vector<bool> stale;            // Bloco a conferir antes de executar
+    uint64_t native_cycles;
+    uint64_t fallback_cycles;
+};
+
+#endif // AOTENGINE_H
@@ -0,0 +1,54 @@
+#ifndef AOTPROGRAM_H
+#define AOTPROGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+class Chip8;
+
+// Estado da VM visto pelo código gerado pelo chip8_aot. Os campos apontam para
+// a instância de Chip8; instruções com efeitos fora da CPU (tela, timers de
+// escrita, escritas em memória) passam por execute(), que usa os mesmos
+// handlers do interpretador.
+struct AotContext {
+    uint8_t* V;
+    uint16_t* I;
+    uint16_t* PC;
+    uint16_t* stack;
+    uint8_t* SP;
+    const uint8_t* memory;
+    Chip8* chip;
+
+    void execute(uint16_t opcode);          // Chip8::execute_opcode
+    uint8_t random();                       // CXNN (RNG da instância)
+    bool key_pressed(uint8_t key) const;    // EX9E / EXA1
+    uint8_t delay_timer() const;            // FX07
+};
+
+// Um bloco básico traduzido: executa todas as instruções, grava o PC seguinte e
+// retorna quantas executou (menos que instructions se parou antes de um erro
+// de pilha, que fica para o interpretador reportar).
+using AotBlockFn = uint32_t (*)(AotContext&);
+
+struct AotBlock {
+    uint16_t start;        // Endereço da primeira instrução
+    uint16_t bytes;        // Bytes de código cobertos
+    uint16_t instructions;
+    uint32_t code_offset;  // Bytes originais em AotProgram::code (conferidos antes de executar)
+    AotBlockFn run;
+};
+
+// Programa gerado para uma ROM: os blocos só rodam enquanto a memória tiver os
+// mesmos bytes da tradução (código automodificado volta ao interpretador)
+struct AotProgram {
+    const char* name;
+    const uint8_t* code;
+    const AotBlock* blocks;
+    uint32_t block_count;
+};
+
+// Registro dos programas compilados no executável (ver AotRegistry.cpp.in)
+void aot_register_program(const AotProgram* program);
+void register_aot_programs(); // Gerado pelo CMake a partir de CHIP8_AOT_ROMS
+
+#endif // AOTPROGRAM_H
@@ -0,0 +1,222 @@
+#include "aot/AotTranslator.h"
+#include "Chip8.h"
+#include "Disassembler.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Como a instrução termina (ou não) um bloco básico
+enum class AotFlow : uint8_t {
+    Linear,  // Segue para pc + 2
+    Store,   // FX33/FX55 (o código pode ter mudado) e FX18 (ciclo da escrita de ST): executa e fecha o bloco
+    Skip,    // pc + 2 ou pc + 4
+    Jump,    // 1NNN
+    Call,    // 2NNN
+    Return,  // 00EE
+    Fallback // Executada pelo interpretador: BNNN, FX0A, 0NNN, laço de espera, inválidas
+};
+
+static AotFlow classify(const Chip8& chip, uint16_t pc, uint16_t opcode) {
+    const uint8_t n = opcode & 0xF, nn = opcode & 0xFF;
+    switch (opcode >> 12) {
+        case 0x0: return opcode == 0x00E0 ? AotFlow::Linear : opcode == 0x00EE ? AotFlow::Return : AotFlow::Fallback;
+        case 0x1: return chip.is_idle_loop(pc) ? AotFlow::Fallback : AotFlow::Jump; // O interpretador pula o laço
+        case 0x2: return AotFlow::Call;
+        case 0x3: case 0x4: return AotFlow::Skip;
+        case 0x5: case 0x9: return n == 0 ? AotFlow::Skip : AotFlow::Fallback;
+        case 0x8: return (n <= 0x7 || n == 0xE) ? AotFlow::Linear : AotFlow::Fallback;
+        case 0xB: return AotFlow::Fallback; // Salto calculado
+        case 0xE: return (nn == 0x9E || nn == 0xA1) ? AotFlow::Skip : AotFlow::Fallback;
+        case 0xF:
+            switch (nn) {
+                case 0x07: case 0x15: case 0x1E: case 0x29: case 0x65: return AotFlow::Linear;
+                case 0x18: case 0x33: case 0x55: return AotFlow::Store;
+                case 0x9E: case 0xA1: return AotFlow::Skip;
+                default: return AotFlow::Fallback; // FX0A e inválidas
+            }
+        default: return AotFlow::Linear; // 6, 7, A, C, D
+    }
+}
+
+static std::string format(const char* pattern, ...) {
+    char text[160];
+    va_list args;
+    va_start(args, pattern);
+    std::vsnprintf(text, sizeof(text), pattern, args);
+    va_end(args);
+    return text;
+}
+
+// C++ de uma instrução linear, com a mesma semântica (e ordem de escrita de VF) dos handlers
+static std::string emit_linear(uint16_t opcode) {
+    const unsigned x = (opcode >> 8) & 0xF, y = (opcode >> 4) & 0xF, n = opcode & 0xF;
+    const unsigned nn = opcode & 0xFF, nnn = opcode & 0xFFF;
+    switch (opcode >> 12) {
+        case 0x6: return format("V[0x%X] = 0x%02X;", x, nn);
+        case 0x7: return format("V[0x%X] += 0x%02X;", x, nn);
+        case 0x8:
+            switch (n) {
+                case 0x0: return format("V[0x%X] = V[0x%X]; V[0xF] = 0;", x, y);
+                case 0x1: return format("V[0x%X] = V[0x%X] | V[0x%X]; V[0xF] = 0;", x, x, y);
+                case 0x2: return format("V[0x%X] = V[0x%X] & V[0x%X]; V[0xF] = 0;", x, x, y);
+                case 0x3: return format("V[0x%X] = V[0x%X] ^ V[0x%X]; V[0xF] = 0;", x, x, y);
+                case 0x4: return format("{ uint16_t r = (uint16_t)V[0x%X] + (uint16_t)V[0x%X]; V[0xF] = r > 255 ? 1 : 0; V[0x%X] = (uint8_t)r; }", x, y, x);
+                case 0x5: return format("V[0xF] = V[0x%X] >= V[0x%X] ? 1 : 0; V[0x%X] = V[0x%X] - V[0x%X];", x, y, x, x, y);
+                case 0x6: return format("V[0xF] = V[0x%X] & 0x1; V[0x%X] >>= 1;", x, x);
+                case 0x7: return format("V[0xF] = V[0x%X] >= V[0x%X] ? 1 : 0; V[0x%X] = V[0x%X] - V[0x%X];", y, x, x, y, x);
+                default: return format("V[0xF] = (V[0x%X] & 0x80) >> 7; V[0x%X] <<= 1;", x, x); // 8XYE
+            }
+        case 0xA: return format("*c.I = 0x%03X;", nnn);
+        case 0xC: return format("V[0x%X] = c.random() & 0x%02X;", x, nn);
+        case 0xF:
+            switch (nn) {
+                case 0x07: return format("V[0x%X] = c.delay_timer();", x);
+                case 0x1E: return format("*c.I += V[0x%X];", x);
+                case 0x29: return format("*c.I = V[0x%X] * 5;", x);
+                case 0x65: return format("for (int i = 0; i <= 0x%X; ++i) V[i] = c.memory[(*c.I + i) & 0xFFF];\n    *c.I += 0x%X;", x, x + 1);
+                default: break; // FX15 (e FX18/FX33/FX55): handlers do interpretador
+            }
+            return format("c.execute(0x%04X);", opcode);
+        default: return format("c.execute(0x%04X);", opcode); // 00E0, DXYN
+    }
+}
+
+static std::string emit_skip_condition(uint16_t opcode) {
+    const unsigned x = (opcode >> 8) & 0xF, y = (opcode >> 4) & 0xF, nn = opcode & 0xFF;
+    switch (opcode >> 12) {
+        case 0x3: return format("V[0x%X] == 0x%02X", x, nn);
+        case 0x4: return format("V[0x%X] != 0x%02X", x, nn);
+        case 0x5: return format("V[0x%X] == V[0x%X]", x, y);
+        case 0x9: return format("V[0x%X] != V[0x%X]", x, y);
+        default: return format(nn == 0x9E ? "c.key_pressed(V[0x%X])" : "!c.key_pressed(V[0x%X])", x); // EX/FX 9E, A1
+    }
+}
+
+bool translate_rom(const Chip8& chip, const char* name, std::ostream& out, AotTranslationStats& stats) {
+    const uint8_t* memory = chip.get_memory().data();
+    auto read = [memory](uint32_t address) { return (uint16_t)((memory[address] << 8) | memory[address + 1]); };
+    constexpr uint32_t LAST_PC = 0xFFE; // PC e cache de decodificação são de 12 bits
+
+    // --- 1. Desmontagem recursiva a partir de 0x200 ---
+    std::vector<bool> visited(4096), leader(4096), fallback(4096);
+    std::vector<uint32_t> worklist = {0x200};
+    leader[0x200] = true;
+    auto branch_to = [&](uint32_t target) {
+        target &= 0xFFF;
+        leader[target] = true;
+        worklist.push_back(target);
+    };
+    while (!worklist.empty()) {
+        uint32_t pc = worklist.back();
+        worklist.pop_back();
+        while (pc <= LAST_PC && !visited[pc]) {
+            visited[pc] = true;
+            const uint16_t opcode = read(pc);
+            const AotFlow flow = classify(chip, (uint16_t)pc, opcode);
+            if (flow == AotFlow::Linear) {
+                pc += 2;
+                if (pc <= LAST_PC && visited[pc]) leader[pc] = true; // Junção com código já percorrido
+                continue;
+            }
+            switch (flow) {
+                case AotFlow::Store: branch_to(pc + 2); break;
+                case AotFlow::Skip: branch_to(pc + 2); branch_to(pc + 4); break;
+                case AotFlow::Jump: branch_to(opcode & 0xFFF); break;
+                case AotFlow::Call: branch_to(opcode & 0xFFF); branch_to(pc + 2); break;
+                case AotFlow::Fallback:
+                    fallback[pc] = true;
+                    if ((opcode & 0xF000) == 0x1000) branch_to(opcode & 0xFFF); // Laço de espera
+                    else if ((opcode & 0xF000) != 0xB000) branch_to(pc + 2);
+                    break;
+                default: break; // Return: sucessor só conhecido em tempo de execução
+            }
+            break;
+        }
+    }
+
+    // --- 2. Blocos básicos: de cada líder até um desvio, o próximo líder ou um fallback ---
+    struct Block { uint32_t start, instructions; uint32_t code_offset; std::string body; };
+    std::vector<Block> blocks;
+    std::vector<uint8_t> code;
+    stats = AotTranslationStats{};
+    for (uint32_t start = 0; start <= LAST_PC; ++start) {
+        if (visited[start]) ++stats.reachable;
+        if (fallback[start]) ++stats.fallbacks;
+        if (!leader[start] || !visited[start] || fallback[start]) continue;
+
+        Block block{start, 0, (uint32_t)code.size(), std::string()};
+        uint32_t pc = start;
+        while (true) {
+            const uint16_t opcode = read(pc);
+            const AotFlow flow = classify(chip, (uint16_t)pc, opcode);
+            const uint32_t count = ++block.instructions;
+            const uint32_t next = (pc + 2) & 0xFFFF, skip = (pc + 4) & 0xFFFF;
+            block.body += format("    // 0x%03X  %04X  %s\n", pc, opcode, disassemble(opcode).c_str());
+            if (flow == AotFlow::Linear) {
+                block.body += "    " + emit_linear(opcode) + "\n";
+            } else if (flow == AotFlow::Store) {
+                block.body += format("    c.execute(0x%04X);\n    *c.PC = 0x%03X;\n    return %u;\n", opcode, next, count);
+                break;
+            } else if (flow == AotFlow::Skip) {
+                block.body += format("    *c.PC = (%s) ? 0x%03X : 0x%03X;\n    return %u;\n",
+                                     emit_skip_condition(opcode).c_str(), skip, next, count);
+                break;
+            } else if (flow == AotFlow::Jump) {
+                block.body += format("    *c.PC = 0x%03X;\n    return %u;\n", opcode & 0xFFF, count);
+                break;
+            } else if (flow == AotFlow::Call) {
+                // Pilha cheia: devolve o PC do CALL para o interpretador reportar o erro
+                block.body += format("    if (*c.SP >= 16) { *c.PC = 0x%03X; return %u; }\n", pc, count - 1);
+                block.body += format("    c.stack[(*c.SP)++] = 0x%03X;\n    *c.PC = 0x%03X;\n    return %u;\n",
+                                     next, opcode & 0xFFF, count);
+                break;
+            } else { // Return
+                block.body += format("    if (*c.SP == 0) { *c.PC = 0x%03X; return %u; }\n", pc, count - 1);
+                block.body += format("    *c.PC = c.stack[--*c.SP];\n    return %u;\n", count);
+                break;
+            }
+            if (count == AOT_MAX_BLOCK_INSTR || next > LAST_PC || leader[next] || fallback[next] || !visited[next]) {
+                if (next <= LAST_PC) leader[next] = true; // Bloco cortado no limite: o resto vira outro bloco
+                block.body += format("    *c.PC = 0x%03X;\n    return %u;\n", next, count);
+                break;
+            }
+            pc = next;
+        }
+        const uint32_t end = std::min<uint32_t>(pc + 2, 4096);
+        code.insert(code.end(), memory + start, memory + end);
+        stats.translated += block.instructions;
+        blocks.push_back(std::move(block));
+    }
+    stats.blocks = blocks.size();
+    if (blocks.empty()) {
+        std::cerr << "ERRO: Nenhum codigo traduzivel alcancado a partir de 0x200." << std::endl;
+        return false;
+    }
+
+    // --- 3. Unidade de tradução ---
+    out << "// Gerado pelo chip8_aot (programa '" << name << "'). Nao editar.\n"
+        << "#include \"aot/AotProgram.h\"\n\nnamespace {\n\n";
+    for (const Block& block : blocks) {
+        out << format("// 0x%03X: %u instrucoes\n", block.start, block.instructions)
+            << format("uint32_t block_%03X(AotContext& c) {\n", block.start);
+        if (block.body.find("V[") != std::string::npos) out << "    uint8_t* const V = c.V;\n";
+        out << block.body << "}\n\n";
+    }
+    out << "const uint8_t CODE[] = {";
+    for (size_t i = 0; i < code.size(); ++i) {
+        out << (i % 16 ? " " : "\n    ") << format("0x%02X,", code[i]);
+    }
+    out << "\n};\n\nconst AotBlock BLOCKS[] = {\n";
+    for (const Block& block : blocks) {
+        const uint32_t bytes = std::min<uint32_t>(block.instructions * 2, 4096 - block.start);
+        out << format("    {0x%03X, %u, %u, %u, block_%03X},\n", block.start, bytes, block.instructions,
+                      block.code_offset, block.start);
+    }
+    out << "};\n\n} // namespace\n\n"
+        << "extern const AotProgram AOT_PROGRAM_" << name << " = {\"" << name << "\", CODE, BLOCKS, "
+        << blocks.size() << "};\n";
+    return (bool)out;
+}
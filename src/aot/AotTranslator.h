@@ -0,0 +1,26 @@
+#ifndef AOTTRANSLATOR_H
+#define AOTTRANSLATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+class Chip8;
+
+constexpr uint32_t AOT_MAX_BLOCK_INSTR = 32; // Limite de instruções por bloco gerado
+
+// Resumo da tradução (impresso pelo chip8_aot)
+struct AotTranslationStats {
+    size_t reachable;  // Instruções alcançadas a partir de 0x200
+    size_t translated; // Instruções em blocos gerados
+    size_t fallbacks;  // Instruções deixadas para o interpretador (BNNN, FX0A, ...)
+    size_t blocks;
+};
+
+// Tradutor ahead-of-time: desmonta recursivamente o código alcançável a partir
+// de 0x200 na memória da VM (ROM já carregada por load_rom), monta o grafo de
+// fluxo de controle e emite uma unidade de tradução C++ com uma função por bloco
+// básico e o AotProgram "AOT_PROGRAM_<name>". Apenas o CHIP-8 clássico.
+bool translate_rom(const Chip8& chip, const char* name, std::ostream& out, AotTranslationStats& stats);
+
+#endif // AOTTRANSLATOR_H
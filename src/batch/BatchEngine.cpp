@@ -0,0 +1,592 @@
+#include "BatchEngine.h"
+#include "Chip8.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+// Grupos vetoriais por passo: além disso o fluxo está divergente demais e as
+// lanes restantes seguem pelo caminho escalar
+constexpr uint32_t MAX_VECTOR_GROUPS = 8;
+// Grupos menores que isso não compensam uma passada vetorial pelos blocos
+constexpr uint32_t MIN_VECTOR_LANES = 4;
+constexpr uint32_t BATCH_MAX_ROM_SIZE = 0xFFF - 0x200;
+
+BatchEngine::BatchEngine(uint32_t lanes)
+    : lane_count(lanes),
+      padded_lanes((lanes + 31) & ~31u),
+      block_count((lanes + 31) / 32),
+      use_avx2(has_avx2()),
+      memory((size_t)padded_lanes * MEMORY_STRIDE),
+      V(16 * (size_t)padded_lanes),
+      I(padded_lanes),
+      PC(padded_lanes),
+      SP(padded_lanes),
+      stack(16 * (size_t)padded_lanes),
+      DT(padded_lanes),
+      ST(padded_lanes),
+      rng_state(padded_lanes),
+      keys(padded_lanes),
+      key_register(padded_lanes),
+      state(padded_lanes),
+      framebuffers(padded_lanes),
+      processed(block_count),
+      group(block_count),
+      vector_instructions(0),
+      scalar_instructions(0)
+{
+    // Semente padrão determinística por lane (varreduras reprodutíveis)
+    for (uint32_t lane = 0; lane < padded_lanes; ++lane) {
+        rng_state[lane] = lane + 1;
+    }
+    reset();
+}
+
+bool BatchEngine::has_avx2() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+void BatchEngine::reset() {
+    std::fill(memory.begin(), memory.end(), 0);
+    std::fill(V.begin(), V.end(), 0);
+    std::fill(I.begin(), I.end(), 0);
+    std::fill(PC.begin(), PC.end(), 0x200);
+    std::fill(SP.begin(), SP.end(), 0);
+    std::fill(stack.begin(), stack.end(), 0);
+    std::fill(DT.begin(), DT.end(), 0);
+    std::fill(ST.begin(), ST.end(), 0);
+    std::fill(keys.begin(), keys.end(), 0);
+    std::fill(key_register.begin(), key_register.end(), 0);
+    for (uint32_t lane = 0; lane < padded_lanes; ++lane) {
+        state[lane] = lane < lane_count ? LANE_RUNNING : LANE_PADDING;
+        framebuffers[lane] = Framebuffer{};
+        if (lane < lane_count) {
+            std::memcpy(lane_memory(lane), CHIP8_FONTSET, sizeof(CHIP8_FONTSET));
+        }
+    }
+}
+
+bool BatchEngine::load_rom(const char* filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel abrir o arquivo ROM: " << filename << std::endl;
+        return false;
+    }
+    std::streampos size = file.tellg();
+    if (size <= 0 || size > BATCH_MAX_ROM_SIZE) {
+        std::cerr << "ERRO: Tamanho de ROM invalido (" << size << " bytes): " << filename << std::endl;
+        return false;
+    }
+    std::vector<char> buffer(size);
+    file.seekg(0, std::ios::beg);
+    if (!file.read(buffer.data(), size)) {
+        std::cerr << "ERRO: Falha ao ler o conteudo do arquivo ROM: " << filename << std::endl;
+        return false;
+    }
+
+    reset();
+    for (uint32_t lane = 0; lane < lane_count; ++lane) {
+        std::memcpy(lane_memory(lane) + 0x200, buffer.data(), buffer.size());
+    }
+    return true;
+}
+
+void BatchEngine::set_rng_seed(uint32_t lane, uint32_t seed) {
+    rng_state[lane] = seed ? seed : 1; // xorshift não pode ter estado zero
+}
+
+void BatchEngine::set_key(uint32_t lane, uint8_t key, bool pressed) {
+    key &= 0xF;
+    if (pressed) keys[lane] |= (1u << key);
+    else keys[lane] &= ~(1u << key);
+
+    // Libera um FX0A pendente (mesma regra de Chip8::set_key_pressed)
+    if (pressed && state[lane] == LANE_WAITING) {
+        reg(key_register[lane], lane) = key;
+        state[lane] = LANE_RUNNING;
+        PC[lane] += 2;
+    }
+}
+
+uint64_t BatchEngine::run_cycles(uint32_t cycles) {
+    uint64_t executed = 0;
+    for (uint32_t step = 0; step < cycles; ++step) {
+#if defined(__x86_64__) || defined(__i386__)
+        uint64_t stepped = use_avx2 ? step_avx2() : step_scalar();
+#else
+        uint64_t stepped = step_scalar();
+#endif
+        if (stepped == 0) break; // Todas as lanes paradas ou aguardando tecla
+        executed += stepped;
+    }
+    return executed;
+}
+
+void BatchEngine::update_timers() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (use_avx2) {
+        update_timers_avx2();
+        return;
+    }
+#endif
+    for (uint32_t lane = 0; lane < padded_lanes; ++lane) {
+        if (DT[lane] > 0) DT[lane]--;
+        if (ST[lane] > 0) ST[lane]--;
+    }
+}
+
+// =====================================================================
+// CAMINHO ESCALAR (uma lane por vez)
+// =====================================================================
+
+uint64_t BatchEngine::step_scalar() {
+    uint64_t executed = 0;
+    for (uint32_t lane = 0; lane < lane_count; ++lane) {
+        if (state[lane] != LANE_RUNNING) continue;
+        step_lane(lane);
+        ++executed;
+    }
+    scalar_instructions += executed;
+    return executed;
+}
+
+void BatchEngine::step_lane(uint32_t lane) {
+    const uint8_t* mem = lane_memory(lane);
+    uint16_t pc = PC[lane];
+    uint16_t opcode = (mem[pc & 0xFFF] << 8) | mem[(pc + 1) & 0xFFF];
+    PC[lane] = pc + 2;
+    execute_lane(lane, opcode);
+}
+
+void BatchEngine::fault_lane(uint32_t lane, const char* message) {
+    // No Chip8 estes erros encerram o processo; aqui apenas a lane para
+    std::cerr << "ERRO: lane " << lane << ": " << message << " (lane parada)." << std::endl;
+    state[lane] = LANE_FAULTED;
+}
+
+void BatchEngine::execute_lane(uint32_t lane, uint16_t opcode) {
+    const uint8_t x = (opcode >> 8) & 0xF;
+    const uint8_t y = (opcode >> 4) & 0xF;
+    const uint8_t n = opcode & 0xF;
+    const uint8_t nn = opcode & 0xFF;
+    const uint16_t nnn = opcode & 0xFFF;
+
+    uint8_t* mem = lane_memory(lane);
+    uint8_t& vx = reg(x, lane);
+    uint8_t& vy = reg(y, lane);
+    uint8_t& vf = reg(0xF, lane);
+    uint16_t& pc = PC[lane];
+    uint16_t& i_reg = I[lane];
+
+    switch (opcode >> 12) {
+        case 0x0:
+            if (nn == 0xE0) {
+                // Só o CHIP-8 clássico: lores, plano 0
+                for (int y = 0; y < CHIP8_HEIGHT; ++y) framebuffers[lane].row(y) = 0;
+            } else if (nn == 0xEE) {
+                if (SP[lane] == 0) { fault_lane(lane, "RET de uma stack vazia"); return; }
+                pc = stack[lane * 16 + --SP[lane]];
+            }
+            break; // 0NNN: ignorado
+        case 0x1: pc = nnn; break;
+        case 0x2:
+            if (SP[lane] >= 16) { fault_lane(lane, "Stack Overflow (limite 16)"); return; }
+            stack[lane * 16 + SP[lane]++] = pc;
+            pc = nnn;
+            break;
+        case 0x3: if (vx == nn) pc += 2; break;
+        case 0x4: if (vx != nn) pc += 2; break;
+        case 0x5: if (n == 0 && vx == vy) pc += 2; break;
+        case 0x6: vx = nn; break;
+        case 0x7: vx += nn; break;
+        case 0x8:
+            switch (n) {
+                case 0x0: vx = vy; vf = 0; break;
+                case 0x1: vx = vx | vy; vf = 0; break;
+                case 0x2: vx = vx & vy; vf = 0; break;
+                case 0x3: vx = vx ^ vy; vf = 0; break;
+                case 0x4: { uint16_t result = (uint16_t)vx + (uint16_t)vy; vf = (result > 255) ? 1 : 0; vx = (uint8_t)result; break; }
+                case 0x5: vf = (vx >= vy) ? 1 : 0; vx = vx - vy; break;
+                case 0x6: vf = vx & 0x1; vx >>= 1; break;
+                case 0x7: vf = (vy >= vx) ? 1 : 0; vx = vy - vx; break;
+                case 0xE: vf = (vx & 0x80) >> 7; vx <<= 1; break;
+                default: break; // Desconhecido: ignorado
+            }
+            break;
+        case 0x9: if (n == 0 && vx != vy) pc += 2; break;
+        case 0xA: i_reg = nnn; break;
+        case 0xB: pc = nnn + reg(0, lane); break;
+        case 0xC: {
+            uint32_t value = rng_state[lane];
+            value ^= value << 13;
+            value ^= value >> 17;
+            value ^= value << 5;
+            rng_state[lane] = value;
+            vx = (uint8_t)(value >> 24) & nn;
+            break;
+        }
+        case 0xD: {
+            // Mesmo desenho por linhas de Chip8::op_drw
+            uint8_t start_x = vx % CHIP8_WIDTH;
+            uint8_t start_y = vy % CHIP8_HEIGHT;
+            Framebuffer& rows = framebuffers[lane];
+            uint64_t collision = 0;
+            for (int sprite_row = 0; sprite_row < n; ++sprite_row) {
+                uint64_t sprite_bits = (uint64_t)mem[(i_reg + sprite_row) & 0xFFF] << 56;
+                uint64_t row_bits = (sprite_bits >> start_x) | (sprite_bits << ((64 - start_x) & 63));
+                uint64_t& line = rows.row((start_y + sprite_row) % CHIP8_HEIGHT);
+                collision |= line & row_bits;
+                line ^= row_bits;
+            }
+            vf = collision ? 1 : 0;
+            break;
+        }
+        case 0xE:
+        case 0xF:
+            if (nn == 0x9E) { // SKP (o decodificador do Chip8 aceita E e F)
+                if (vx < 16 && (keys[lane] >> vx) & 1) pc += 2;
+                break;
+            }
+            if (nn == 0xA1) { // SKNP
+                if (!(vx < 16 && (keys[lane] >> vx) & 1)) pc += 2;
+                break;
+            }
+            if ((opcode >> 12) == 0xE) break;
+            switch (nn) {
+                case 0x07: vx = DT[lane]; break;
+                case 0x0A:
+                    state[lane] = LANE_WAITING;
+                    key_register[lane] = x;
+                    pc -= 2;
+                    break;
+                case 0x15: DT[lane] = vx; break;
+                case 0x18: ST[lane] = vx; break;
+                case 0x1E: i_reg += vx; break;
+                case 0x29: i_reg = vx * 5; break;
+                case 0x33: {
+                    uint8_t value = vx;
+                    mem[i_reg & 0xFFF] = value / 100;
+                    mem[(i_reg + 1) & 0xFFF] = (value / 10) % 10;
+                    mem[(i_reg + 2) & 0xFFF] = value % 10;
+                    break;
+                }
+                case 0x55:
+                    for (int r = 0; r <= x; ++r) mem[(i_reg + r) & 0xFFF] = reg(r, lane);
+                    i_reg += x + 1;
+                    break;
+                case 0x65:
+                    for (int r = 0; r <= x; ++r) reg(r, lane) = mem[(i_reg + r) & 0xFFF];
+                    i_reg += x + 1;
+                    break;
+                default: break; // Desconhecido: ignorado
+            }
+            break;
+    }
+}
+
+bool BatchEngine::is_vectorizable(uint16_t opcode) {
+    switch (opcode >> 12) {
+        case 0x1: case 0x3: case 0x4: case 0x6: case 0x7:
+        case 0x8: case 0xA: case 0xC:
+            return true;
+        case 0x5: case 0x9:
+            return (opcode & 0xF) == 0;
+        case 0xF:
+            switch (opcode & 0xFF) {
+                case 0x07: case 0x15: case 0x18: case 0x1E: case 0x29: return true;
+                default: return false;
+            }
+        default:
+            return false; // Pilha, desenho, teclado e memória: por lane
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// =====================================================================
+// CAMINHO AVX2 (32 lanes de 8 bits / 16 de 16 bits / 8 de 32 bits)
+// =====================================================================
+
+AVX2_TARGET static inline __m256i load256(const void* p) {
+    return _mm256_loadu_si256((const __m256i*)p);
+}
+
+// Escreve value apenas nas lanes com mask ligada
+AVX2_TARGET static inline void store_masked(void* p, __m256i value, __m256i mask) {
+    __m256i old = _mm256_loadu_si256((const __m256i*)p);
+    _mm256_storeu_si256((__m256i*)p, _mm256_blendv_epi8(old, value, mask));
+}
+
+// Bits de grupo -> máscaras por lane de 8, 16 e 32 bits
+AVX2_TARGET static inline __m256i byte_mask(uint32_t bits) {
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit = _mm256_set1_epi64x((long long)0x8040201008040201ULL);
+    __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32((int)bits), spread);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+}
+
+AVX2_TARGET static inline __m256i word_mask(uint32_t bits) {
+    const __m256i bit = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048,
+                                          4096, 8192, 16384, (short)32768);
+    return _mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16((short)bits), bit), bit);
+}
+
+AVX2_TARGET static inline __m256i dword_mask(uint32_t bits) {
+    const __m256i bit = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int)bits), bit), bit);
+}
+
+// Duas comparações de 16 lanes x 16 bits -> 32 bits (um por lane)
+AVX2_TARGET static inline uint32_t movemask_words(__m256i lo, __m256i hi) {
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xD8);
+    return (uint32_t)_mm256_movemask_epi8(packed);
+}
+
+AVX2_TARGET uint64_t BatchEngine::step_avx2() {
+    // Lanes paradas/aguardando tecla já contam como processadas neste passo
+    const __m256i running = _mm256_set1_epi8(LANE_RUNNING);
+    for (uint32_t b = 0; b < block_count; ++b) {
+        processed[b] = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(load256(&state[b * 32]), running));
+    }
+
+    uint64_t executed = 0;
+    uint32_t groups = 0;
+    uint32_t b = 0;
+    while (true) {
+        while (b < block_count && processed[b] == 0xFFFFFFFFu) ++b;
+        if (b == block_count) break;
+
+        if (groups == MAX_VECTOR_GROUPS) {
+            // Fluxo muito divergente: as lanes restantes seguem pelo caminho escalar
+            for (; b < block_count; ++b) {
+                uint32_t pending = ~processed[b];
+                while (pending) {
+                    step_lane(b * 32 + __builtin_ctz(pending));
+                    pending &= pending - 1;
+                    ++executed;
+                    ++scalar_instructions;
+                }
+                processed[b] = 0xFFFFFFFFu;
+            }
+            break;
+        }
+        ++groups;
+
+        // A primeira lane pendente lidera o grupo
+        const uint32_t leader = b * 32 + __builtin_ctz(~processed[b]);
+        const uint16_t pc = PC[leader];
+        const uint8_t* mem = lane_memory(leader);
+        const uint16_t opcode = (mem[pc & 0xFFF] << 8) | mem[(pc + 1) & 0xFFF];
+
+        uint32_t count;
+        if ((pc & 0xFFF) == 0xFFF) {
+            // Opcode cruzando o fim da memória: o gather não cobre o wrapping
+            std::fill(group.begin() + b, group.end(), 0);
+            group[b] = 1u << (leader & 31);
+            count = 1;
+        } else {
+            count = build_group(b, pc, opcode);
+        }
+
+        if (count >= MIN_VECTOR_LANES && is_vectorizable(opcode)) {
+            execute_group_avx2(b, pc, opcode);
+            vector_instructions += count;
+            for (uint32_t g = b; g < block_count; ++g) processed[g] |= group[g];
+        } else {
+            for (uint32_t g = b; g < block_count; ++g) {
+                uint32_t pending = group[g];
+                while (pending) {
+                    step_lane(g * 32 + __builtin_ctz(pending));
+                    pending &= pending - 1;
+                }
+                processed[g] |= group[g];
+            }
+            scalar_instructions += count;
+        }
+        executed += count;
+    }
+    return executed;
+}
+
+AVX2_TARGET uint32_t BatchEngine::build_group(uint32_t first_block, uint16_t pc, uint16_t opcode) {
+    const __m256i pc_vec = _mm256_set1_epi16((short)pc);
+    // Os dois bytes do opcode na ordem da memória (leitura little-endian de 32 bits)
+    const __m256i code_vec = _mm256_set1_epi32((opcode >> 8) | ((opcode & 0xFF) << 8));
+    const __m256i low16 = _mm256_set1_epi32(0xFFFF);
+    const __m256i lane_offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                    _mm256_set1_epi32(MEMORY_STRIDE));
+    const int* code_base = (const int*)(memory.data() + (pc & 0xFFF));
+
+    uint32_t count = 0;
+    for (uint32_t b = first_block; b < block_count; ++b) {
+        const uint32_t base = b * 32;
+        uint32_t bits = ~processed[b];
+        if (bits) {
+            __m256i lo = _mm256_cmpeq_epi16(load256(&PC[base]), pc_vec);
+            __m256i hi = _mm256_cmpeq_epi16(load256(&PC[base + 16]), pc_vec);
+            bits &= movemask_words(lo, hi);
+        }
+        // Mesmo PC não basta: a lane pode ter reescrito o próprio código (FX33/FX55)
+        for (uint32_t k = 0; k < 4 && bits; ++k) {
+            const uint32_t chunk = (bits >> (k * 8)) & 0xFF;
+            if (!chunk) continue;
+            __m256i index = _mm256_add_epi32(lane_offsets, _mm256_set1_epi32((int)((base + k * 8) * MEMORY_STRIDE)));
+            __m256i code = _mm256_and_si256(_mm256_i32gather_epi32(code_base, index, 1), low16);
+            uint32_t same = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(code, code_vec)));
+            bits &= ~((chunk & ~same) << (k * 8));
+        }
+        group[b] = bits;
+        count += __builtin_popcount(bits);
+    }
+    return count;
+}
+
+AVX2_TARGET void BatchEngine::execute_group_avx2(uint32_t first_block, uint16_t pc, uint16_t opcode) {
+    const uint8_t x = (opcode >> 8) & 0xF;
+    const uint8_t y = (opcode >> 4) & 0xF;
+    const uint8_t n = opcode & 0xF;
+    const uint8_t nn = opcode & 0xFF;
+    const uint16_t nnn = opcode & 0xFFF;
+    const uint8_t kind = opcode >> 12;
+
+    const __m256i nn_vec = _mm256_set1_epi8((char)nn);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i all_ones = _mm256_set1_epi8(-1);
+    // Todas as lanes do grupo partem do mesmo PC
+    const __m256i pc_next = _mm256_set1_epi16((short)(kind == 0x1 ? nnn : (uint16_t)(pc + 2)));
+    const __m256i two = _mm256_set1_epi16(2);
+
+    for (uint32_t b = first_block; b < block_count; ++b) {
+        const uint32_t bits = group[b];
+        if (!bits) continue;
+
+        const uint32_t base = b * 32;
+        const __m256i m8 = byte_mask(bits);
+        const __m256i m16_lo = word_mask(bits & 0xFFFF);
+        const __m256i m16_hi = word_mask(bits >> 16);
+        uint8_t* vx = &V[x * padded_lanes + base];
+        uint8_t* vy = &V[y * padded_lanes + base];
+        uint8_t* vf = &V[0xF * padded_lanes + base];
+        __m256i skip = zero; // 0xFF onde o salto condicional foi tomado
+
+        switch (kind) {
+            case 0x3: skip = _mm256_cmpeq_epi8(load256(vx), nn_vec); break;
+            case 0x4: skip = _mm256_xor_si256(_mm256_cmpeq_epi8(load256(vx), nn_vec), all_ones); break;
+            case 0x5: skip = _mm256_cmpeq_epi8(load256(vx), load256(vy)); break;
+            case 0x9: skip = _mm256_xor_si256(_mm256_cmpeq_epi8(load256(vx), load256(vy)), all_ones); break;
+            case 0x6: store_masked(vx, nn_vec, m8); break;
+            case 0x7: store_masked(vx, _mm256_add_epi8(load256(vx), nn_vec), m8); break;
+            case 0x8: {
+                // Mesma ordem de leituras/escritas do escalar (importa quando x ou y é F)
+                __m256i a = load256(vx);
+                __m256i c = load256(vy);
+                switch (n) {
+                    case 0x0: store_masked(vx, c, m8); store_masked(vf, zero, m8); break;
+                    case 0x1: store_masked(vx, _mm256_or_si256(a, c), m8); store_masked(vf, zero, m8); break;
+                    case 0x2: store_masked(vx, _mm256_and_si256(a, c), m8); store_masked(vf, zero, m8); break;
+                    case 0x3: store_masked(vx, _mm256_xor_si256(a, c), m8); store_masked(vf, zero, m8); break;
+                    case 0x4: {
+                        __m256i sum = _mm256_add_epi8(a, c);
+                        __m256i carry = _mm256_andnot_si256(_mm256_cmpeq_epi8(_mm256_adds_epu8(a, c), sum), one);
+                        store_masked(vf, carry, m8);
+                        store_masked(vx, sum, m8);
+                        break;
+                    }
+                    case 0x5:
+                        store_masked(vf, _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(a, c), a), one), m8);
+                        store_masked(vx, _mm256_sub_epi8(load256(vx), load256(vy)), m8);
+                        break;
+                    case 0x6:
+                        store_masked(vf, _mm256_and_si256(a, one), m8);
+                        store_masked(vx, _mm256_and_si256(_mm256_srli_epi16(load256(vx), 1), _mm256_set1_epi8(0x7F)), m8);
+                        break;
+                    case 0x7:
+                        store_masked(vf, _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(c, a), c), one), m8);
+                        store_masked(vx, _mm256_sub_epi8(load256(vy), load256(vx)), m8);
+                        break;
+                    case 0xE:
+                        store_masked(vf, _mm256_and_si256(_mm256_srli_epi16(a, 7), one), m8);
+                        a = load256(vx);
+                        store_masked(vx, _mm256_add_epi8(a, a), m8);
+                        break;
+                    default: break; // Desconhecido: ignorado
+                }
+                break;
+            }
+            case 0xA: {
+                const __m256i address = _mm256_set1_epi16((short)nnn);
+                store_masked(&I[base], address, m16_lo);
+                store_masked(&I[base + 16], address, m16_hi);
+                break;
+            }
+            case 0xC: {
+                // xorshift32 em 8 lanes de 32 bits por vez; o byte alto de cada estado é o sorteio
+                __m256i drawn[4];
+                for (uint32_t k = 0; k < 4; ++k) {
+                    uint32_t* rng = &rng_state[base + k * 8];
+                    __m256i value = load256(rng);
+                    value = _mm256_xor_si256(value, _mm256_slli_epi32(value, 13));
+                    value = _mm256_xor_si256(value, _mm256_srli_epi32(value, 17));
+                    value = _mm256_xor_si256(value, _mm256_slli_epi32(value, 5));
+                    store_masked(rng, value, dword_mask((bits >> (k * 8)) & 0xFF));
+                    drawn[k] = _mm256_srli_epi32(value, 24);
+                }
+                __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(drawn[0], drawn[1]),
+                                                     _mm256_packus_epi32(drawn[2], drawn[3]));
+                packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                store_masked(vx, _mm256_and_si256(packed, nn_vec), m8);
+                break;
+            }
+            case 0xF: {
+                const __m128i vx_lo = _mm_loadu_si128((const __m128i*)vx);
+                const __m128i vx_hi = _mm_loadu_si128((const __m128i*)(vx + 16));
+                switch (nn) {
+                    case 0x07: store_masked(vx, load256(&DT[base]), m8); break;
+                    case 0x15: store_masked(&DT[base], load256(vx), m8); break;
+                    case 0x18: store_masked(&ST[base], load256(vx), m8); break;
+                    case 0x1E:
+                        store_masked(&I[base], _mm256_add_epi16(load256(&I[base]), _mm256_cvtepu8_epi16(vx_lo)), m16_lo);
+                        store_masked(&I[base + 16], _mm256_add_epi16(load256(&I[base + 16]), _mm256_cvtepu8_epi16(vx_hi)), m16_hi);
+                        break;
+                    case 0x29: {
+                        const __m256i glyph_size = _mm256_set1_epi16(5);
+                        store_masked(&I[base], _mm256_mullo_epi16(_mm256_cvtepu8_epi16(vx_lo), glyph_size), m16_lo);
+                        store_masked(&I[base + 16], _mm256_mullo_epi16(_mm256_cvtepu8_epi16(vx_hi), glyph_size), m16_hi);
+                        break;
+                    }
+                }
+                break;
+            }
+        }
+
+        // PC = próximo endereço (+2 onde o salto condicional foi tomado)
+        const __m256i skip_lo = _mm256_and_si256(_mm256_cvtepi8_epi16(_mm256_castsi256_si128(skip)), two);
+        const __m256i skip_hi = _mm256_and_si256(_mm256_cvtepi8_epi16(_mm256_extracti128_si256(skip, 1)), two);
+        store_masked(&PC[base], _mm256_add_epi16(pc_next, skip_lo), m16_lo);
+        store_masked(&PC[base + 16], _mm256_add_epi16(pc_next, skip_hi), m16_hi);
+    }
+}
+
+AVX2_TARGET void BatchEngine::update_timers_avx2() {
+    // Subtração saturada: decrementa apenas timers maiores que zero
+    const __m256i one = _mm256_set1_epi8(1);
+    for (uint32_t b = 0; b < block_count; ++b) {
+        __m256i* dt = (__m256i*)&DT[b * 32];
+        __m256i* st = (__m256i*)&ST[b * 32];
+        _mm256_storeu_si256(dt, _mm256_subs_epu8(_mm256_loadu_si256(dt), one));
+        _mm256_storeu_si256(st, _mm256_subs_epu8(_mm256_loadu_si256(st), one));
+    }
+}
+
+#endif
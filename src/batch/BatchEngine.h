@@ -0,0 +1,104 @@
+#ifndef BATCHENGINE_H
+#define BATCHENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "components/Display.h"
+
+// Motor em lote: N VMs Chip-8 (lanes) com a mesma ROM, guardadas em estrutura
+// de arrays (SoA): cada registrador V[x], I, PC, SP, DT e ST é um vetor com uma
+// posição por lane. Todas as lanes avançam juntas, uma instrução por passo.
+//
+// A cada passo as lanes com o mesmo PC e o mesmo opcode formam um grupo; grupos
+// de instruções aritméticas, saltos condicionais, timers e CXNN são executados
+// com AVX2 (32 lanes por operação). Instruções com efeitos por lane (DXYN, FX33,
+// FX55/65, pilha, teclado) e lanes cujo fluxo divergiu seguem pelo caminho escalar.
+// A semântica é a mesma de Chip8::execute_opcode.
+class BatchEngine {
+public:
+    explicit BatchEngine(uint32_t lane_count);
+
+    bool load_rom(const char* filename);      // Mesma ROM em todas as lanes (reinicia o estado)
+    void set_rng_seed(uint32_t lane, uint32_t seed);
+    void set_key(uint32_t lane, uint8_t key, bool pressed);
+
+    uint64_t run_cycles(uint32_t cycles);     // Até cycles passos; retorna instruções somadas das lanes
+    void update_timers();                     // Tique de 60Hz em todas as lanes
+
+    static bool has_avx2();                   // CPU do host suporta o caminho vetorial
+    void set_vector_enabled(bool enabled) { use_avx2 = enabled && has_avx2(); }
+    bool is_vector_enabled() const { return use_avx2; }
+
+    // --- Acesso somente leitura (por lane) ---
+    uint32_t get_lane_count() const { return lane_count; }
+    uint16_t get_PC(uint32_t lane) const { return PC[lane]; }
+    uint16_t get_I(uint32_t lane) const { return I[lane]; }
+    uint8_t get_V(uint32_t lane, uint8_t index) const { return V[(index & 0xF) * padded_lanes + lane]; }
+    bool is_waiting_for_key(uint32_t lane) const { return state[lane] == LANE_WAITING; }
+    bool is_faulted(uint32_t lane) const { return state[lane] == LANE_FAULTED; }
+    const Framebuffer& get_pixel_buffer(uint32_t lane) const { return framebuffers[lane]; }
+
+    // Instruções executadas pelo caminho vetorial e pelo escalar (soma das lanes)
+    uint64_t get_vector_instructions() const { return vector_instructions; }
+    uint64_t get_scalar_instructions() const { return scalar_instructions; }
+
+private:
+    enum LaneState : uint8_t {
+        LANE_RUNNING = 0,
+        LANE_WAITING = 1, // FX0A pendente
+        LANE_FAULTED = 2, // Erro fatal (RET com pilha vazia, stack overflow): lane parada
+        LANE_PADDING = 3  // Posições extras até múltiplo de 32
+    };
+
+    void reset();
+    uint8_t* lane_memory(uint32_t lane) { return memory.data() + (size_t)lane * MEMORY_STRIDE; }
+    uint8_t& reg(uint8_t index, uint32_t lane) { return V[index * padded_lanes + lane]; }
+
+    // Caminho escalar (fallback por lane)
+    uint64_t step_scalar();
+    void step_lane(uint32_t lane);
+    void execute_lane(uint32_t lane, uint16_t opcode);
+    void fault_lane(uint32_t lane, const char* message);
+
+#if defined(__x86_64__) || defined(__i386__)
+    // Caminho AVX2 (compilado com target("avx2"), escolhido em tempo de execução)
+    uint64_t step_avx2();
+    uint32_t build_group(uint32_t first_block, uint16_t pc, uint16_t opcode);
+    void execute_group_avx2(uint32_t first_block, uint16_t pc, uint16_t opcode);
+    void update_timers_avx2();
+#endif
+    static bool is_vectorizable(uint16_t opcode);
+
+    // Memória de cada lane separada por MEMORY_STRIDE (a folga permite ler
+    // 4 bytes com gather a partir de qualquer PC sem invadir a lane seguinte)
+    static constexpr uint32_t MEMORY_STRIDE = 4096 + 64;
+
+    uint32_t lane_count;
+    uint32_t padded_lanes;
+    uint32_t block_count;   // Blocos de 32 lanes
+    bool use_avx2;
+
+    std::vector<uint8_t> memory;
+    std::vector<uint8_t> V;         // V[x * padded_lanes + lane]
+    std::vector<uint16_t> I;
+    std::vector<uint16_t> PC;
+    std::vector<uint8_t> SP;
+    std::vector<uint16_t> stack;    // stack[lane * 16 + nível]
+    std::vector<uint8_t> DT;
+    std::vector<uint8_t> ST;
+    std::vector<uint32_t> rng_state;
+    std::vector<uint16_t> keys;     // Bit k = tecla k pressionada
+    std::vector<uint8_t> key_register;
+    std::vector<uint8_t> state;     // LaneState
+    std::vector<Framebuffer> framebuffers;
+
+    // Máscaras de 32 bits por bloco usadas durante um passo
+    std::vector<uint32_t> processed;
+    std::vector<uint32_t> group;
+
+    uint64_t vector_instructions;
+    uint64_t scalar_instructions;
+};
+
+#endif // BATCHENGINE_H
@@ -0,0 +1,78 @@
+#include "Beeper.h"
+#include <cmath>
+#include <cstring>
+
+constexpr uint32_t WAVETABLE_SIZE = 256;
+constexpr size_t RAMP_SAMPLES = 32; // ~0,7 ms de ataque/liberação nas transições
+
+// Tabelas calculadas uma vez (estáticas locais: inicialização segura entre threads)
+struct Wavetables {
+    float square[WAVETABLE_SIZE];
+    float sine[WAVETABLE_SIZE];
+    Wavetables() {
+        for (uint32_t i = 0; i < WAVETABLE_SIZE; ++i) {
+            square[i] = i < WAVETABLE_SIZE / 2 ? BEEP_VOLUME : -BEEP_VOLUME;
+            sine[i] = BEEP_VOLUME * (float)std::sin(2.0 * M_PI * i / WAVETABLE_SIZE);
+        }
+    }
+};
+
+static const Wavetables& wavetables() {
+    static const Wavetables tables;
+    return tables;
+}
+
+Beeper::Beeper(Waveform waveform, uint32_t sample_rate, uint32_t tick_hz)
+    : table(waveform == Waveform::Sine ? wavetables().sine : wavetables().square),
+      sample_rate(sample_rate),
+      tick_hz(tick_hz),
+      tick_remainder(0),
+      phase(0),
+      phase_step((uint32_t)(((uint64_t)BEEP_FREQUENCY << 32) / sample_rate)),
+      was_on(false)
+{}
+
+size_t Beeper::render_tick(const BeepGate& gate, float* out) {
+    // Amostras por tick = sample_rate / tick_hz, carregando a parte fracionária
+    tick_remainder += sample_rate;
+    size_t count = tick_remainder / tick_hz;
+    tick_remainder %= tick_hz;
+
+    // Um trecho por troca: o ciclo da escrita de ST vira a amostra proporcional do quadro
+    const uint32_t frame_cycles = gate.frame_cycles ? gate.frame_cycles : 1;
+    size_t start = 0;
+    bool on = gate.start_on;
+    for (int i = 0; i < gate.change_count; ++i) {
+        size_t end = (size_t)((uint64_t)gate.cycle[i] * count / frame_cycles);
+        if (end > count) end = count;
+        if (end > start) {
+            render_span(on, out + start, end - start);
+            start = end;
+        }
+        on = gate.on[i];
+    }
+    render_span(on, out + start, count - start);
+    return count;
+}
+
+void Beeper::render_span(bool on, float* out, size_t count) {
+    if (count == 0) return;
+    if (!on && !was_on) {
+        std::memset(out, 0, count * sizeof(float));
+        return;
+    }
+
+    // Liga: rampa de subida; desliga: o tom continua só durante a rampa de descida
+    size_t ramp = on != was_on ? (count < RAMP_SAMPLES ? count : RAMP_SAMPLES) : 0;
+    size_t tone = on ? count : ramp;
+    for (size_t i = 0; i < tone; ++i) {
+        out[i] = table[phase >> 24];
+        phase += phase_step;
+    }
+    for (size_t i = 0; i < ramp; ++i) {
+        float gain = (float)(i + 1) / (float)(ramp + 1);
+        out[i] *= on ? gain : 1.0f - gain;
+    }
+    if (!on) std::memset(out + tone, 0, (count - tone) * sizeof(float));
+    was_on = on;
+}
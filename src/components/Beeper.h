@@ -0,0 +1,60 @@
+#ifndef BEEPER_H
+#define BEEPER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Forma de onda do bipe
+enum class Waveform {
+    Square,
+    Sine
+};
+
+constexpr uint32_t AUDIO_SAMPLE_RATE = 44100; // Amostras/s (mono, float)
+constexpr uint32_t BEEP_FREQUENCY = 440;      // Tom do bipe (A4)
+constexpr float BEEP_VOLUME = 0.2f;           // Amplitude (evita clipping)
+
+// Estado do bipe durante um quadro de 60Hz: ligado ou não no início e as trocas
+// causadas por FX18 no meio do quadro, no ciclo emulado em que aconteceram
+struct BeepGate {
+    static constexpr int MAX_CHANGES = 8; // Além disso, a última troca fica com o estado final
+    uint32_t frame_cycles;                // Ciclos do quadro (escala de cycle[])
+    bool start_on;
+    uint8_t change_count;
+    bool on[MAX_CHANGES];
+    uint32_t cycle[MAX_CHANGES];          // Ciclo da troca, contado do início do quadro
+};
+
+// Sintetizador do bipe em tempo emulado: cada tick de 60Hz gera as amostras
+// do quadro que terminou, ligando e desligando o tom na amostra que corresponde
+// ao ciclo de cada escrita de ST. Assim o som dura exatamente o tempo emulado
+// em que ST > 0, independentemente do relógio do host.
+//
+// As amostras vêm de uma wavetable de 256 pontos percorrida por um acumulador
+// de fase de 32 bits (sem sin() por amostra). Uma rampa curta nas transições
+// evita estalos. Determinístico: a mesma sequência de ticks gera os mesmos bytes.
+class Beeper {
+public:
+    explicit Beeper(Waveform waveform = Waveform::Square, uint32_t sample_rate = AUDIO_SAMPLE_RATE,
+                    uint32_t tick_hz = 60);
+
+    // Maior número de amostras que render_tick pode gerar (tamanho do buffer)
+    size_t get_max_tick_samples() const { return sample_rate / tick_hz + 1; }
+    uint32_t get_sample_rate() const { return sample_rate; }
+
+    // Amostras de um tick conforme o gate do quadro; retorna quantas foram escritas
+    size_t render_tick(const BeepGate& gate, float* out);
+
+private:
+    void render_span(bool on, float* out, size_t count);
+
+    const float* table;       // Wavetable da forma de onda (compartilhada)
+    uint32_t sample_rate;
+    uint32_t tick_hz;
+    uint32_t tick_remainder;  // Parte fracionária de sample_rate / tick_hz acumulada
+    uint32_t phase;           // Fase da onda (8 bits altos = índice na tabela)
+    uint32_t phase_step;
+    bool was_on;
+};
+
+#endif // BEEPER_H
@@ -1,23 +1,106 @@
 #include "Display.h"
+#include "../Log.h"
+#include <algorithm> // Para std::fill
 #include <cstring> // Para std::memset
 #include <iostream>
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_video.h>
+#endif
 
 // Construtor do Display (apenas limpa o buffer na inicialização)
-Display::Display() : window(nullptr), renderer(nullptr), scale_factor(0) {
-    clear_screen();
-    std::cout << "DEBUG: Display 64x32 buffer inicializado." << std::endl;
+#ifndef CHIP8_HEADLESS
+Display::Display() : window(nullptr), renderer(nullptr), texture(nullptr), scale_factor(0), dirty(true) {
+#else
+Display::Display() : dirty(true) {
+#endif
+    set_hires(false);
+    LOG_DEBUG("Display 64x32/128x64 buffer inicializado.");
 }
 
-void Display::clear_screen() {
-    // Zera o buffer inteiro (monocromático)
-    std::memset(pixel_buffer.data(), 0, CHIP8_PIXEL_COUNT);
+void Display::clear_screen(uint8_t plane_mask) {
+    // Zera as linhas da resolução atual nos planos selecionados (as demais já estão zeradas)
+    const int height = pixel_buffer.height();
+    for (int p = 0; p < FRAMEBUFFER_PLANES; ++p) {
+        if (plane_mask & (1 << p)) {
+            std::fill(pixel_buffer.planes[p].begin(), pixel_buffer.planes[p].begin() + height, Framebuffer::Row{});
+        }
+    }
+    dirty = true;
+}
+
+void Display::set_hires(bool hires) {
+    std::memset(&pixel_buffer, 0, sizeof(pixel_buffer));
+    pixel_buffer.hires = hires ? 1 : 0;
+    dirty = true;
+}
+
+// As rolagens movem linhas inteiras (verticais) ou deslocam as palavras de cada
+// linha (horizontais); o que sai da tela é descartado e entra em branco.
+void Display::scroll_down(int rows, uint8_t plane_mask) {
+    const int height = pixel_buffer.height();
+    if (rows > height) rows = height;
+    for (int p = 0; p < FRAMEBUFFER_PLANES; ++p) {
+        if (!(plane_mask & (1 << p))) continue;
+        auto& plane = pixel_buffer.planes[p];
+        for (int y = height - 1; y >= rows; --y) plane[y] = plane[y - rows];
+        for (int y = 0; y < rows; ++y) plane[y] = Framebuffer::Row{};
+    }
+    dirty = true;
+}
+
+void Display::scroll_up(int rows, uint8_t plane_mask) {
+    const int height = pixel_buffer.height();
+    if (rows > height) rows = height;
+    for (int p = 0; p < FRAMEBUFFER_PLANES; ++p) {
+        if (!(plane_mask & (1 << p))) continue;
+        auto& plane = pixel_buffer.planes[p];
+        for (int y = 0; y < height - rows; ++y) plane[y] = plane[y + rows];
+        for (int y = height - rows; y < height; ++y) plane[y] = Framebuffer::Row{};
+    }
+    dirty = true;
+}
+
+void Display::scroll_right(int columns, uint8_t plane_mask) {
+    const int height = pixel_buffer.height();
+    const bool hires = pixel_buffer.hires;
+    for (int p = 0; p < FRAMEBUFFER_PLANES; ++p) {
+        if (!(plane_mask & (1 << p))) continue;
+        for (int y = 0; y < height; ++y) {
+            Framebuffer::Row& row = pixel_buffer.planes[p][y];
+            if (hires) {
+                // 128 bits: o que sai da palavra 0 entra na palavra 1
+                row[1] = (row[1] >> columns) | (row[0] << (64 - columns));
+            }
+            row[0] >>= columns;
+        }
+    }
+    dirty = true;
+}
+
+void Display::scroll_left(int columns, uint8_t plane_mask) {
+    const int height = pixel_buffer.height();
+    const bool hires = pixel_buffer.hires;
+    for (int p = 0; p < FRAMEBUFFER_PLANES; ++p) {
+        if (!(plane_mask & (1 << p))) continue;
+        for (int y = 0; y < height; ++y) {
+            Framebuffer::Row& row = pixel_buffer.planes[p][y];
+            if (hires) {
+                row[0] = (row[0] << columns) | (row[1] >> (64 - columns));
+                row[1] <<= columns;
+            } else {
+                row[0] <<= columns;
+            }
+        }
+    }
+    dirty = true;
 }
 
 // =====================================================================
 // IMPLEMENTAÇÃO SDL (CRITÉRIO DE ACEITAÇÃO DA ISSUE 9)
+// (Ausente no build headless: nenhuma janela ou renderer é criado)
 // =====================================================================
+#ifndef CHIP8_HEADLESS
 
 bool Display::init_graphics(uint32_t scale) {
     scale_factor = scale;
@@ -44,52 +127,70 @@ bool Display::init_graphics(uint32_t scale) {
         return false;
     }
     
+    // Criar a textura streaming na maior resolução (hires); o renderer escala no SDL_RenderTexture
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                HIRES_WIDTH, HIRES_HEIGHT);
+    if (!texture) {
+        std::cerr << "ERRO SDL: Textura nao pode ser criada: " << SDL_GetError() << std::endl;
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        return false;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST); // Pixels nítidos (sem filtragem)
+
     // Define a cor de fundo inicial (preto)
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
     SDL_RenderPresent(renderer);
-    std::cout << "DEBUG: Janela SDL criada (" << width << "x" << height << ")." << std::endl;
+    LOG_DEBUG("Janela SDL criada (%dx%d).", (int)width, (int)height);
     return true;
 }
 
-void Display::render() {
-    if (!renderer) return;
+void Display::present(const Framebuffer& frame) {
+    if (!renderer || !texture) return;
 
-    // 1. Limpar a tela física (preto)
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    // Cores 0..3 (plano 0 | plano 1 << 1): preto, branco e dois cinzas do XO-CHIP
+    static const uint32_t PALETTE[4] = { 0xFF000000u, 0xFFFFFFFFu, 0xFFAAAAAAu, 0xFF555555u };
 
-    // 2. Definir a cor do pixel (branco - monocromático)
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); 
-
-    // 3. Varrer o buffer de pixels Chip-8
-    for (int y = 0; y < CHIP8_HEIGHT; ++y) {
-        for (int x = 0; x < CHIP8_WIDTH; ++x) {
-            size_t index = x + y * CHIP8_WIDTH;
-            
-            if (pixel_buffer[index] == 1) { // Se o pixel estiver 'ligado'
-                // Desenha o retângulo escalonado (Critério Fator de Escala)
-                SDL_FRect rect = {
-                (float)(x * scale_factor), // <-- CASTING explícito para float
-                (float)(y * scale_factor), // <-- CASTING explícito para float
-                (float)scale_factor, 
-                (float)scale_factor
-            };
-                SDL_RenderFillRect(renderer, &rect);
+    // 1. Converter as linhas de bits em ARGB8888 apenas na área da resolução atual
+    const int width = frame.width(), height = frame.height();
+    const SDL_Rect area = { 0, 0, width, height };
+    void* texture_pixels = nullptr;
+    int pitch = 0;
+    if (!SDL_LockTexture(texture, &area, &texture_pixels, &pitch)) {
+        LOG_ERROR("SDL: Falha ao travar a textura: %s", SDL_GetError());
+        return;
+    }
+    for (int y = 0; y < height; ++y) {
+        uint32_t* out = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(texture_pixels) + y * pitch);
+        for (int w = 0; w < width / 64; ++w) {
+            uint64_t low = frame.planes[0][y][w], high = frame.planes[1][y][w];
+            for (int x = 0; x < 64; ++x) {
+                // Cor pelo par de bits, sem desvio
+                uint32_t color = (uint32_t)((low >> (63 - x)) & 1u) | ((uint32_t)((high >> (63 - x)) & 1u) << 1);
+                out[w * 64 + x] = PALETTE[color];
             }
         }
     }
+    SDL_UnlockTexture(texture);
 
-    // 4. Apresentar o que foi desenhado na tela
+    // 2. Uma única cópia escalada da área ativa para a janela inteira e apresentação
+    const SDL_FRect source = { 0.0f, 0.0f, (float)width, (float)height };
+    SDL_RenderTexture(renderer, texture, &source, nullptr);
     SDL_RenderPresent(renderer);
 }
 
 void Display::destroy_graphics() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
     if (renderer) {
         SDL_DestroyRenderer(renderer);
     }
     if (window) {
         SDL_DestroyWindow(window);
     }
-    std::cout << "DEBUG: Janela SDL destruida." << std::endl;
-}
\ No newline at end of file
+    LOG_DEBUG("Janela SDL destruida.");
+}
+#endif // CHIP8_HEADLESS
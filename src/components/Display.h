@@ -2,35 +2,92 @@
 #define DISPLAY_H
 
 #include <cstdint>
+#include <cstring>
 #include <array>
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL.h> 
+#endif
 
-// Resolução padrão do Chip-8
+// Resolução padrão do Chip-8 (e modo lores do SUPER-CHIP/XO-CHIP)
 constexpr int CHIP8_WIDTH = 64;
 constexpr int CHIP8_HEIGHT = 32; 
 constexpr int CHIP8_PIXEL_COUNT = CHIP8_WIDTH * CHIP8_HEIGHT; // 2048
 
+// Modo hires do SUPER-CHIP/XO-CHIP e bit-planes do XO-CHIP
+constexpr int HIRES_WIDTH = 128;
+constexpr int HIRES_HEIGHT = 64;
+constexpr int FRAMEBUFFER_PLANES = 2;    // Cor do pixel = bit do plano 0 | bit do plano 1 << 1
+constexpr int FRAMEBUFFER_ROW_WORDS = 2; // Palavras de 64 bits por linha (128 colunas)
+
+// Framebuffer compactado: cada linha de cada plano é um par de palavras de 64 bits
+// (colunas 0..63 e 64..127). O bit 63 da palavra 0 é a coluna x = 0, de modo que um
+// byte de sprite deslocado para os bits 63..56 já está alinhado com a coluna 0.
+// Em lores (64x32) só a palavra 0 das linhas 0..31 é usada: o CHIP-8 clássico
+// desenha, limpa e apresenta a mesma quantidade de dados que um framebuffer 64x32.
+struct Framebuffer {
+    using Row = std::array<uint64_t, FRAMEBUFFER_ROW_WORDS>;
+    std::array<std::array<Row, HIRES_HEIGHT>, FRAMEBUFFER_PLANES> planes;
+    uint8_t hires;       // 1 = 128x64
+    uint8_t reserved[7]; // Zero (sem padding implícito: comparado e gravado byte a byte)
+
+    int width() const { return hires ? HIRES_WIDTH : CHIP8_WIDTH; }
+    int height() const { return hires ? HIRES_HEIGHT : CHIP8_HEIGHT; }
+    // Plano 0, colunas 0..63: a linha inteira no modo clássico
+    uint64_t& row(int y) { return planes[0][y][0]; }
+    uint64_t row(int y) const { return planes[0][y][0]; }
+    // Cor 0..3 do pixel (bit 0 = plano 0, bit 1 = plano 1)
+    uint8_t get_pixel(int x, int y) const {
+        const int word = x >> 6, bit = 63 - (x & 63);
+        return (uint8_t)(((planes[0][y][word] >> bit) & 1) | (((planes[1][y][word] >> bit) & 1) << 1));
+    }
+    bool operator==(const Framebuffer& other) const { return std::memcmp(this, &other, sizeof(Framebuffer)) == 0; }
+    bool operator!=(const Framebuffer& other) const { return !(*this == other); }
+};
+static_assert(sizeof(Framebuffer) == 2056, "Framebuffer deve ter 2056 bytes (sem padding implícito)");
+
 class Display {
 public:
     Display();
 
-    // Ação principal da Opcode 00E0: Limpar a tela
-    void clear_screen();
+    // Ação principal da Opcode 00E0: Limpar a tela (planos em plane_mask)
+    void clear_screen(uint8_t plane_mask = 0x3);
+
+    // SUPER-CHIP/XO-CHIP: troca lores/hires (limpa a tela) e rolagens dos planos em
+    // plane_mask, em pixels da resolução atual, operando sobre as linhas compactadas
+    void set_hires(bool hires);
+    void scroll_down(int rows, uint8_t plane_mask);
+    void scroll_up(int rows, uint8_t plane_mask);
+    void scroll_right(int columns, uint8_t plane_mask);
+    void scroll_left(int columns, uint8_t plane_mask);
     
     // O buffer de pixels que a CPU manipulará. 
-    // Usamos uint8_t para representar cada pixel (0 ou 1)
-    std::array<uint8_t, CHIP8_PIXEL_COUNT> pixel_buffer;
+    // Cada linha é compactada (1 bit por pixel), permitindo XOR/colisão da linha inteira no DXYN
+    Framebuffer pixel_buffer;
 
+    uint8_t get_pixel(int x, int y) const { return pixel_buffer.get_pixel(x, y); }
+
+    // Rastreamento de alterações: 00E0/DXYN marcam o quadro como sujo e só quadros
+    // sujos são publicados para a apresentação
+    void mark_dirty() { dirty = true; }
+    void clear_dirty() { dirty = false; }
+    bool is_dirty() const { return dirty; }
+
+#ifndef CHIP8_HEADLESS
     // --- NOVOS MÉTODOS PÚBLICOS PARA GERENCIAMENTO DE GRÁFICOS ---
     bool init_graphics(uint32_t scale); // Inicializa SDL Window/Renderer e salva o fator de escala
-    void render();                      // Desenha o pixel_buffer no Renderer
+    void present(const Framebuffer& frame); // Envia um quadro para a textura e apresenta
     void destroy_graphics();            // Destrói Window/Renderer
 
 private:
     // --- MEMBROS PRIVADOS SDL ---
     SDL_Window* window;
     SDL_Renderer* renderer;
+    SDL_Texture* texture;  // Textura streaming 128x64 (ARGB8888); lores usa o canto 64x32
     uint32_t scale_factor; // Fator de zoom (e.g., 10x)
+#endif
+
+private:
+    bool dirty;
 };
 
 #endif // DISPLAY_H
\ No newline at end of file
@@ -1,19 +1,24 @@
 #include "Input.h"
+#include "../Log.h"
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_keyboard.h> 
-#include <iostream>
+#endif
 #include <cstring> // Para std::memset (Embora você use fill)
 
 Input::Input() {
     reset_keys();
+#ifndef CHIP8_HEADLESS
     setup_key_map();
-    std::cout << "DEBUG: Input (Teclado) inicializado." << std::endl;
+#endif
+    LOG_DEBUG("Input (Teclado) inicializado.");
 }
 
 void Input::reset_keys() {
     key_state.fill(false);
 }
 
+#ifndef CHIP8_HEADLESS
 void Input::setup_key_map() {
     // 1ª LINHA: 1 2 3 C -> Teclas 1, 2, 3, 4
     key_map[0x1] = SDLK_1; 
@@ -38,27 +43,32 @@ void Input::setup_key_map() {
     key_map[0x0] = SDLK_X;  // Chip-8 tecla 0 -> Física X
     key_map[0xB] = SDLK_C;  // Chip-8 tecla B -> Física C
     key_map[0xF] = SDLK_V;  // Chip-8 tecla F -> Física V
+
+    // Tabela inversa: o tratamento de eventos não percorre key_map
+    key_lookup.fill(-1);
+    for (int i = 0; i < CHIP8_KEY_COUNT; ++i) {
+        if (key_map[i] < KEY_LOOKUP_SIZE) key_lookup[key_map[i]] = (int8_t)i;
+    }
 }
 
 
-void Input::handle_event(SDL_Event& event) {
+int Input::handle_event(SDL_Event& event) {
     if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) {
         // Critério: Captura de Eventos e Matriz de Estado
         SDL_Keycode key_code = event.key.key;
         bool is_pressed = (event.type == SDL_EVENT_KEY_DOWN);
         
-        // Percorre o mapeamento para encontrar a tecla Chip-8 correspondente
-        for (int i = 0; i < CHIP8_KEY_COUNT; ++i) {
-            if (key_code == key_map[i]) { 
-                key_state[i] = is_pressed;
-                
-                // Critério de Validação: Adicionar Log
-                std::cout << "LOG: Tecla Chip-8 0x" << std::hex << i 
-                          << (is_pressed ? " PRESSIONADA" : " LIBERADA") 
-                          << " (Fisica: " << SDL_GetKeyName(key_code) << ")" << std::endl;
-                
-                return; 
-            }
+        int i = map_key(key_code);
+        if (i >= 0) {
+            key_state[i] = is_pressed;
+            
+            // Critério de Validação: Adicionar Log
+            LOG_DEBUG("Tecla Chip-8 0x%x %s (Fisica: %s)", (unsigned)i,
+                      is_pressed ? "PRESSIONADA" : "LIBERADA", SDL_GetKeyName(key_code));
+            
+            return is_pressed ? i : -1; 
         }
     }
-}
\ No newline at end of file
+    return -1;
+}
+#endif // CHIP8_HEADLESS
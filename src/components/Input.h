@@ -3,11 +3,14 @@
 
 #include <cstdint>
 #include <array>
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL_keyboard.h> 
 #include <SDL3/SDL.h>
+#endif
 
 // O teclado Chip-8 tem 16 teclas (0 a F)
 constexpr int CHIP8_KEY_COUNT = 16;
+constexpr uint32_t KEY_LOOKUP_SIZE = 128; // Keycodes mapeados são ASCII (dígitos e letras)
 
 class Input {
 public:
@@ -16,16 +19,26 @@ public:
     // Array que armazena o estado de cada tecla (true se pressionada, false se liberada)
     std::array<bool, CHIP8_KEY_COUNT> key_state; 
 
+    void reset_keys();
+
+#ifndef CHIP8_HEADLESS
     // Mapeamento sugerido na especificação (teclas físicas para índices 0-F)
     // O índice corresponde à tecla Chip-8 (0x0 a 0xF)
     std::array<SDL_Keycode, CHIP8_KEY_COUNT> key_map; 
 
+    // Tecla Chip-8 (0x0-0xF) de um keycode ou -1, por consulta direta em tabela
+    int map_key(SDL_Keycode key_code) const {
+        return key_code < KEY_LOOKUP_SIZE ? key_lookup[key_code] : -1;
+    }
+
     // Métodos para o loop principal e opcodes
-    void handle_event(SDL_Event& event);
-    void reset_keys();
+    // Retorna a tecla Chip-8 pressionada pelo evento (0x0-0xF) ou -1
+    int handle_event(SDL_Event& event);
 
 private:
     void setup_key_map();
+    std::array<int8_t, KEY_LOOKUP_SIZE> key_lookup; // Keycode -> tecla Chip-8 (-1 = não mapeado)
+#endif
 };
 
 #endif // INPUT_H
\ No newline at end of file
@@ -1,118 +1,104 @@
 #include "TimerManager.h"
+#include "../Log.h"
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL.h>
+#endif
 #include <iostream>
-#include <cmath> // Para sin() e M_PI
-#include <cstring> // Para memcpy, se necessário
 
-// --- Constantes para Geração de Áudio ---
-const int BEEF_FREQUENCY = 440; // Frequência do beep (A4)
-const int SAMPLE_RATE = 44100;  // Taxa de amostragem padrão
-static double audio_phase = 0.0; // Fase global para continuidade da onda
-SDL_AudioSpec desired_spec;
-
-
-// =====================================================================
-// CRITÉRIO: FUNÇÃO DE CALLBACK PARA GERAR A ONDA SONORA (Deve estar no topo)
-// =====================================================================
-void AudioCallback(void *userdata, Uint8 *stream, int len) {
-
-    // 'len' é o tamanho do buffer em bytes. Convertemos para floats.
-    float *audio_stream = (float *)stream;
-    int num_samples = len / sizeof(float);
-    
-    // CORREÇÃO: Removida a declaração duplicada 'float *audio_stream'
-    // A declaração dentro do for é desnecessária.
-
-    for (int i = 0; i < num_samples; ++i) {
-        // Gera uma onda senoidal (tom puro)
-        float value = sin(audio_phase * 2.0 * M_PI);
-        
-        // Escreve o sample no buffer (volume baixo para evitar clipping)
-        audio_stream[i] = value * 0.2f; 
-        
-        // Atualiza a fase: avança baseado na frequência do beep
-        audio_phase += (double)BEEF_FREQUENCY / SAMPLE_RATE;
-        if (audio_phase >= 1.0) {
-            audio_phase -= 1.0;
-        }
-    }
-}
-
-// =====================================================================
-// GERENCIAMENTO DA CLASSE (TimerManager)
-// =====================================================================
+#ifndef CHIP8_HEADLESS
+// Latência máxima na fila do stream: com mais que isso enfileirado (host adiantado
+// em relação ao dispositivo) o tick é descartado em vez de acumular atraso
+constexpr int AUDIO_MAX_QUEUED_TICKS = 3;
 
 // Construtor (apenas inicializa membros)
-TimerManager::TimerManager() 
-    : delay_timer(0), sound_timer(0), 
-      is_audio_playing(false),
-      audio_device_id(0)
+TimerManager::TimerManager()
+    : delay_timer(0), sound_timer(0), beep_gate{},
+      audio_stream(nullptr)
 {}
 
-// Implementação dos métodos de áudio (agora o AudioCallback está definido)
-// src/components/TimerManager.cpp (Dentro de TimerManager::init_audio())
+// =====================================================================
+// ÁUDIO: SDL_AudioStream alimentado em tempo emulado
+// =====================================================================
 
-bool TimerManager::init_audio() {
-    SDL_AudioSpec desired_spec;
-    
-    // Configuração do formato de áudio (APENAS MEMBROS VÁLIDOS NA SDL3)
-    desired_spec.freq = SAMPLE_RATE;
-    desired_spec.format = SDL_AUDIO_F32; 
-    desired_spec.channels = 1;          
-    audio_device_id = SDL_OpenAudioDevice(
-        0,       // Não captura áudio
-        &desired_spec
-    );
-    
-    if (audio_device_id == 0) {
+bool TimerManager::init_audio(Waveform waveform) {
+    SDL_AudioSpec spec;
+    spec.freq = AUDIO_SAMPLE_RATE;
+    spec.format = SDL_AUDIO_F32;
+    spec.channels = 1;
+    // Sem callback: as amostras são empurradas a cada tick de 60Hz (update_timers)
+    audio_stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, nullptr, nullptr);
+    if (!audio_stream) {
         std::cerr << "ERRO SDL Audio: Falha ao abrir dispositivo de audio: " << SDL_GetError() << std::endl;
         return false;
     }
+    beeper = Beeper(waveform, AUDIO_SAMPLE_RATE);
+    audio_buffer.assign(beeper.get_max_tick_samples(), 0.0f);
 
-    // Pausa o áudio inicialmente (espera ST > 0)
-    SDL_PauseAudioDevice(audio_device_id); 
-    is_audio_playing = false;
+    // O dispositivo abre pausado; a fila vazia toca silêncio até o primeiro tick
+    SDL_ResumeAudioStreamDevice(audio_stream);
 
-    std::cout << "DEBUG: Subsistema de Audio inicializado." << std::endl;
+    LOG_DEBUG("Subsistema de Audio inicializado.");
     return true;
 }
 
 void TimerManager::destroy_audio() {
-    if (audio_device_id != 0) {
-        SDL_CloseAudioDevice(audio_device_id);
-        audio_device_id = 0;
+    if (audio_stream) {
+        SDL_DestroyAudioStream(audio_stream); // Fecha também o dispositivo
+        audio_stream = nullptr;
     }
 }
 
-void TimerManager::start_sound() {
-    if (!is_audio_playing) {
-        SDL_ResumeAudioDevice(audio_device_id); 
-        is_audio_playing = true;
-        std::cout << "DEBUG: Som REAL iniciado (ST > 0)." << std::endl;
+void TimerManager::output_audio_tick(const BeepGate& gate) {
+    if (!audio_stream) return;
+    const int tick_bytes = (int)(audio_buffer.size() * sizeof(float));
+    if (SDL_GetAudioStreamQueued(audio_stream) > AUDIO_MAX_QUEUED_TICKS * tick_bytes) return;
+    size_t samples = beeper.render_tick(gate, audio_buffer.data());
+    SDL_PutAudioStreamData(audio_stream, audio_buffer.data(), (int)(samples * sizeof(float)));
+}
+#else
+// Build headless: não há dispositivo de áudio.
+TimerManager::TimerManager()
+    : delay_timer(0), sound_timer(0), beep_gate{}
+{}
+bool TimerManager::init_audio(Waveform) { return true; }
+void TimerManager::destroy_audio() {}
+void TimerManager::output_audio_tick(const BeepGate&) {}
+#endif // CHIP8_HEADLESS
+
+void TimerManager::record_sound_write(uint32_t cycle) {
+    const bool on = sound_timer > 0;
+    const bool current = beep_gate.change_count ? beep_gate.on[beep_gate.change_count - 1] : beep_gate.start_on;
+    if (on == current) return;
+    if (beep_gate.change_count == BeepGate::MAX_CHANGES) {
+        beep_gate.on[BeepGate::MAX_CHANGES - 1] = on; // Sem espaço: vale o estado final na última troca
+        return;
     }
+    beep_gate.on[beep_gate.change_count] = on;
+    beep_gate.cycle[beep_gate.change_count] = cycle;
+    ++beep_gate.change_count;
 }
 
-void TimerManager::stop_sound() {
-    if (is_audio_playing) {
-        SDL_PauseAudioDevice(audio_device_id); 
-        is_audio_playing = false;
-        std::cout << "DEBUG: Som REAL parado (ST = 0)." << std::endl;
-    }
+void TimerManager::restart_beep_gate() {
+    beep_gate.start_on = sound_timer > 0;
+    beep_gate.change_count = 0;
+}
+
+BeepGate TimerManager::get_beep_gate(uint32_t frame_cycles) const {
+    BeepGate gate = beep_gate;
+    gate.frame_cycles = frame_cycles;
+    return gate;
 }
 
-void TimerManager::update_timers() {
+void TimerManager::update_timers(uint32_t frame_cycles) {
     if (delay_timer > 0) {
         delay_timer--;
     }
 
+    // O quadro que termina neste tick soa enquanto ST > 0 durante ele, trocando
+    // no ciclo de cada FX18: o bipe dura o tempo emulado até o tick em que ST zera
+    output_audio_tick(get_beep_gate(frame_cycles));
     if (sound_timer > 0) {
         sound_timer--;
-        if (sound_timer > 0) {
-            start_sound();
-        } else {
-            stop_sound();
-        }
-    } else {
-        stop_sound();
     }
-}
\ No newline at end of file
+    restart_beep_gate();
+}
@@ -2,7 +2,11 @@
 #define TIMERMANAGER_H
 
 #include <cstdint>
+#include <vector>
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL.h>
+#endif
+#include "Beeper.h"
 
 class TimerManager {
 public:
@@ -11,19 +15,28 @@ public:
     void set_delay_timer(uint8_t value) { delay_timer = value; }
     uint8_t get_sound_timer() const { return sound_timer; }
     void set_sound_timer(uint8_t value) { sound_timer = value; }
-    void start_sound();
-    void stop_sound();
-    void update_timers();
-    bool init_audio(); 
+    bool is_beeping() const { return sound_timer > 0; }
+    // Escrita de ST (FX18) no ciclo `cycle` do quadro: o bipe liga/desliga nesse ponto
+    void record_sound_write(uint32_t cycle);
+    void restart_beep_gate(); // Quadro começa no estado atual de ST, sem trocas (load_state)
+    BeepGate get_beep_gate(uint32_t frame_cycles) const;
+    void update_timers(uint32_t frame_cycles); // Tick de 60Hz; frame_cycles = ciclos do quadro
+    bool init_audio(Waveform waveform); // Stream SDL no dispositivo padrão (false = sem som)
     void destroy_audio();
     
-    
 private:
+    void output_audio_tick(const BeepGate& gate); // Amostras do quadro que terminou neste tick
+
+    friend class JitCompiler; // FX07/FX15 traduzidos acessam o DT diretamente
     uint8_t delay_timer; // Delay Timer (DT)
     uint8_t sound_timer; // Sound Timer (ST)
-    SDL_AudioDeviceID audio_device_id;
-    bool is_audio_playing;
-    
+    BeepGate beep_gate;  // Bipe do quadro em andamento
+#ifndef CHIP8_HEADLESS
+    SDL_AudioStream* audio_stream; // nullptr sem áudio
+    Beeper beeper;
+    std::vector<float> audio_buffer; // Um tick de amostras
+#endif
+
 };
 
 #endif // TIMERMANAGER_H
\ No newline at end of file
@@ -0,0 +1,454 @@
+#include "JitCompiler.h"
+#include "../Chip8.h"
+#include "../Log.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// --- Parâmetros do cache de código ---
+constexpr size_t JIT_CODE_CAPACITY = 1 << 20;     // 1 MB de código executável
+constexpr uint32_t JIT_MAX_BLOCK_INSTR = 64;      // Instruções por bloco
+constexpr size_t JIT_MAX_BLOCK_BYTES = JIT_MAX_BLOCK_INSTR * 512; // Pior caso (FX65 com 16 registradores)
+constexpr uint16_t JIT_HOT_THRESHOLD = 8;         // Execuções antes de compilar um bloco
+
+// Condições x86 (usadas em jcc / cmovcc)
+constexpr uint8_t CC_E = 0x4;
+constexpr uint8_t CC_NE = 0x5;
+constexpr uint8_t CC_L = 0xC;
+
+// Classificação das instruções para a tradução
+enum class JitOpKind { Linear, Terminator, Unsupported };
+
+static JitOpKind classify(uint16_t opcode) {
+    uint8_t n = opcode & 0x000F;
+    uint8_t nn = opcode & 0x00FF;
+    switch (opcode & 0xF000) {
+        case 0x0000: return (opcode == 0x00EE) ? JitOpKind::Terminator : JitOpKind::Unsupported;
+        case 0x1000: case 0x2000: case 0x3000: case 0x4000: case 0xB000:
+            return JitOpKind::Terminator;
+        case 0x5000: case 0x9000:
+            return (n == 0) ? JitOpKind::Terminator : JitOpKind::Unsupported;
+        case 0x6000: case 0x7000: case 0xA000:
+            return JitOpKind::Linear;
+        case 0x8000:
+            return (n <= 0x7 || n == 0xE) ? JitOpKind::Linear : JitOpKind::Unsupported;
+        case 0xF000:
+            switch (nn) {
+                case 0x07: case 0x15: case 0x1E: case 0x29: case 0x65: return JitOpKind::Linear;
+                default: return JitOpKind::Unsupported;
+            }
+        default: // Cxnn, Dxyn, Exnn: interpretador
+            return JitOpKind::Unsupported;
+    }
+}
+
+bool JitCompiler::is_supported() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+JitCompiler::JitCompiler(Chip8& vm)
+    : chip(vm), code_buffer(nullptr), code_capacity(0), code_ptr(nullptr),
+      exit_stub(nullptr), entry(nullptr),
+      blocks_compiled(0), blocks_invalidated(0), native_cycles(0)
+{
+    // Deslocamentos dos campos da VM a partir de rbx (= Chip8*)
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(&chip);
+    off_v = (int32_t)(reinterpret_cast<const uint8_t*>(chip.V) - base);
+    off_i = (int32_t)(reinterpret_cast<const uint8_t*>(&chip.I) - base);
+    off_pc = (int32_t)(reinterpret_cast<const uint8_t*>(&chip.PC) - base);
+    off_sp = (int32_t)(reinterpret_cast<const uint8_t*>(&chip.SP) - base);
+    off_stack = (int32_t)(reinterpret_cast<const uint8_t*>(chip.stack) - base);
+    off_memory = (int32_t)(chip.memory.data() - base);
+    off_delay_timer = (int32_t)(reinterpret_cast<const uint8_t*>(&chip.timers.delay_timer) - base);
+
+    if (!is_supported()) return;
+
+#if defined(_WIN32)
+    void* mem = VirtualAlloc(nullptr, JIT_CODE_CAPACITY, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+#else
+    void* mem = mmap(nullptr, JIT_CODE_CAPACITY, PROT_READ | PROT_WRITE | PROT_EXEC,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) mem = nullptr;
+#endif
+    if (!mem) {
+        LOG_WARN("JIT indisponivel (falha ao alocar memoria executavel). Usando interpretador.");
+        return;
+    }
+    code_buffer = static_cast<uint8_t*>(mem);
+    code_capacity = JIT_CODE_CAPACITY;
+    flush();
+}
+
+JitCompiler::~JitCompiler() {
+    if (!code_buffer) return;
+#if defined(_WIN32)
+    VirtualFree(code_buffer, 0, MEM_RELEASE);
+#else
+    munmap(code_buffer, code_capacity);
+#endif
+}
+
+void JitCompiler::flush() {
+    if (!code_buffer) return;
+    code_ptr = code_buffer;
+    emit_entry_and_exit();
+    block_table.fill(exit_stub);
+    block_length.fill(0);
+    hit_count.fill(0);
+    not_compilable.reset();
+    covered.reset();
+    blocks.clear();
+}
+
+// =====================================================================
+// EMISSÃO DE BYTES
+// =====================================================================
+
+void JitCompiler::emit8(uint8_t value) { *code_ptr++ = value; }
+void JitCompiler::emit16(uint16_t value) { std::memcpy(code_ptr, &value, 2); code_ptr += 2; }
+void JitCompiler::emit32(uint32_t value) { std::memcpy(code_ptr, &value, 4); code_ptr += 4; }
+void JitCompiler::emit64(uint64_t value) { std::memcpy(code_ptr, &value, 8); code_ptr += 8; }
+
+void JitCompiler::emit_jump_to(uint8_t* target) {
+    emit8(0xE9); // jmp rel32
+    emit32((uint32_t)(int32_t)(target - (code_ptr + 4)));
+}
+
+void JitCompiler::emit_jcc_to(uint8_t cc, uint8_t* target) {
+    emit8(0x0F); emit8(0x80 | cc); // jcc rel32
+    emit32((uint32_t)(int32_t)(target - (code_ptr + 4)));
+}
+
+// Helpers de endereçamento [rbx + disp32]
+#define MODRM_RBX(reg) emit8(0x80 | ((reg) << 3) | 0x3)
+
+void JitCompiler::emit_entry_and_exit() {
+    // Trampolim de entrada: salva rbx/r12, rbx = VM, r12d = orçamento, eax = PC
+    entry = reinterpret_cast<EntryFn>(code_ptr);
+    emit8(0x53);                              // push rbx
+    emit8(0x41); emit8(0x54);                 // push r12
+#if defined(_WIN32)
+    emit8(0x48); emit8(0x89); emit8(0xCB);    // mov rbx, rcx
+    emit8(0x45); emit8(0x89); emit8(0xC4);    // mov r12d, r8d
+    emit8(0x0F); emit8(0xB7); MODRM_RBX(0); emit32(off_pc); // movzx eax, word [rbx+PC]
+    emit8(0xFF); emit8(0xE2);                 // jmp rdx
+#else
+    emit8(0x48); emit8(0x89); emit8(0xFB);    // mov rbx, rdi
+    emit8(0x41); emit8(0x89); emit8(0xD4);    // mov r12d, edx
+    emit8(0x0F); emit8(0xB7); MODRM_RBX(0); emit32(off_pc); // movzx eax, word [rbx+PC]
+    emit8(0xFF); emit8(0xE6);                 // jmp rsi
+#endif
+
+    // Saída comum: PC = ax, retorna o orçamento restante
+    exit_stub = code_ptr;
+    emit8(0x66); emit8(0x89); MODRM_RBX(0); emit32(off_pc); // mov word [rbx+PC], ax
+    emit8(0x44); emit8(0x89); emit8(0xE0);    // mov eax, r12d
+    emit8(0x41); emit8(0x5C);                 // pop r12
+    emit8(0x5B);                              // pop rbx
+    emit8(0xC3);                              // ret
+}
+
+void JitCompiler::emit_chain_static(uint16_t target_pc) {
+    // Encadeia pelo slot da tabela: segue o bloco destino se já compilado, senão sai
+    emit8(0xB8); emit32(target_pc);           // mov eax, target
+    emit8(0x48); emit8(0xBA);                 // mov rdx, &block_table[target]
+    emit64(reinterpret_cast<uint64_t>(&block_table[target_pc & 0xFFF]));
+    emit8(0xFF); emit8(0x22);                 // jmp [rdx]
+}
+
+void JitCompiler::emit_chain_dynamic() {
+    // Destino em eax (RET, skips, BNNN)
+    emit8(0x89); emit8(0xC1);                 // mov ecx, eax
+    emit8(0x81); emit8(0xE1); emit32(0xFFF);  // and ecx, 0xFFF
+    emit8(0x48); emit8(0xBA);                 // mov rdx, block_table
+    emit64(reinterpret_cast<uint64_t>(block_table.data()));
+    emit8(0xFF); emit8(0x24); emit8(0xCA);    // jmp [rdx + rcx*8]
+}
+
+void JitCompiler::emit_bail(uint16_t pc, uint32_t refund) {
+    // Devolve ao orçamento as instruções não executadas e sai com PC = pc
+    emit8(0x41); emit8(0x81); emit8(0xC4); emit32(refund); // add r12d, refund
+    emit8(0xB8); emit32(pc);                  // mov eax, pc
+    emit_jump_to(exit_stub);
+}
+
+// =====================================================================
+// TRADUÇÃO DE BLOCOS
+// =====================================================================
+
+bool JitCompiler::compile(uint16_t start) {
+    // 1ª passada: delimita o bloco
+    uint32_t count = 0;
+    uint16_t pc = start;
+    bool terminated = false;
+    while (count < JIT_MAX_BLOCK_INSTR && pc < 0xFFF) {
+        uint16_t opcode = (chip.memory[pc] << 8) | chip.memory[pc + 1];
+        JitOpKind kind = classify(opcode);
+        // JP de laço de espera pelo DT: fica no interpretador, que pula o laço
+        if ((opcode & 0xF000) == 0x1000 && chip.is_idle_loop(pc)) kind = JitOpKind::Unsupported;
+        if (kind == JitOpKind::Unsupported) break;
+        count++;
+        pc += 2;
+        if (kind == JitOpKind::Terminator) { terminated = true; break; }
+    }
+    if (count == 0) {
+        not_compilable.set(start);
+        return false;
+    }
+    if ((size_t)(code_ptr - code_buffer) + JIT_MAX_BLOCK_BYTES > code_capacity) {
+        flush(); // Cache cheio: recomeça do zero
+    }
+
+    uint8_t* block_code = code_ptr;
+
+    // Prólogo: sem orçamento para o bloco inteiro, volta ao despachante (eax = PC)
+    emit8(0x41); emit8(0x81); emit8(0xFC); emit32(count); // cmp r12d, count
+    emit_jcc_to(CC_L, exit_stub);
+    emit8(0x41); emit8(0x81); emit8(0xEC); emit32(count); // sub r12d, count
+
+    const int32_t VF = off_V(0xF);
+    pc = start;
+    for (uint32_t index = 0; index < count; ++index, pc += 2) {
+        uint16_t opcode = (chip.memory[pc] << 8) | chip.memory[pc + 1];
+        uint16_t nnn = opcode & 0x0FFF;
+        uint8_t x = (opcode & 0x0F00) >> 8;
+        uint8_t y = (opcode & 0x00F0) >> 4;
+        uint8_t nn = opcode & 0x00FF;
+        uint8_t n = opcode & 0x000F;
+        uint16_t next = pc + 2;
+
+        // Os acessos seguem a mesma ordem de leitura/escrita do interpretador,
+        // inclusive quando x ou y é VF.
+        auto load_eax = [&](int32_t off) { emit8(0x0F); emit8(0xB6); MODRM_RBX(0); emit32(off); };
+        auto load_ecx = [&](int32_t off) { emit8(0x0F); emit8(0xB6); MODRM_RBX(1); emit32(off); };
+        auto load_edx = [&](int32_t off) { emit8(0x0F); emit8(0xB6); MODRM_RBX(2); emit32(off); };
+        auto store_al = [&](int32_t off) { emit8(0x88); MODRM_RBX(0); emit32(off); };
+        auto store_dl = [&](int32_t off) { emit8(0x88); MODRM_RBX(2); emit32(off); };
+        auto store_imm8 = [&](int32_t off, uint8_t v) { emit8(0xC6); MODRM_RBX(0); emit32(off); emit8(v); };
+
+        switch (opcode & 0xF000) {
+            case 0x0000: { // 00EE: RET
+                load_ecx(off_sp);
+                emit8(0x85); emit8(0xC9);                       // test ecx, ecx
+                uint8_t* jz = code_ptr; emit_jcc_to(CC_E, code_ptr); // patch abaixo
+                emit8(0xFF); emit8(0xC9);                       // dec ecx
+                emit8(0x88); MODRM_RBX(1); emit32(off_sp);      // mov [SP], cl
+                emit8(0x0F); emit8(0xB7); emit8(0x84); emit8(0x4B); emit32(off_stack); // movzx eax, word [rbx+rcx*2+stack]
+                emit_chain_dynamic();
+                // Stack vazia: o interpretador reexecuta e reporta o erro fatal
+                uint8_t* bail = code_ptr;
+                emit_bail(pc, count - index);
+                int32_t rel = (int32_t)(bail - (jz + 6));
+                std::memcpy(jz + 2, &rel, 4);
+                break;
+            }
+            case 0x1000: // 1nnn: JP
+                emit_chain_static(nnn);
+                break;
+            case 0x2000: { // 2nnn: CALL
+                load_ecx(off_sp);
+                emit8(0x83); emit8(0xF9); emit8(16);            // cmp ecx, 16
+                uint8_t* jae = code_ptr; emit8(0x0F); emit8(0x83); emit32(0); // jae bail
+                emit8(0x66); emit8(0xC7); emit8(0x84); emit8(0x4B); emit32(off_stack); emit16(next); // stack[SP] = next
+                emit8(0xFE); MODRM_RBX(0); emit32(off_sp);      // inc byte [SP]
+                emit_chain_static(nnn);
+                uint8_t* bail = code_ptr;
+                emit_bail(pc, count - index);
+                int32_t rel = (int32_t)(bail - (jae + 6));
+                std::memcpy(jae + 2, &rel, 4);
+                break;
+            }
+            case 0x3000: case 0x4000: // 3xnn / 4xnn: SE / SNE Vx, byte
+                load_ecx(off_V(x));
+                emit8(0xB8); emit32(next);                      // mov eax, next
+                emit8(0xBA); emit32(next + 2);                  // mov edx, next + 2
+                emit8(0x81); emit8(0xF9); emit32(nn);           // cmp ecx, nn
+                emit8(0x0F); emit8(0x40 | (((opcode & 0xF000) == 0x3000) ? CC_E : CC_NE)); emit8(0xC2); // cmovcc eax, edx
+                emit_chain_dynamic();
+                break;
+            case 0x5000: case 0x9000: // 5xy0 / 9xy0: SE / SNE Vx, Vy
+                load_ecx(off_V(x));
+                load_edx(off_V(y));
+                emit8(0x39); emit8(0xD1);                       // cmp ecx, edx
+                emit8(0xB8); emit32(next);                      // mov eax, next
+                emit8(0xBA); emit32(next + 2);                  // mov edx, next + 2
+                emit8(0x0F); emit8(0x40 | (((opcode & 0xF000) == 0x5000) ? CC_E : CC_NE)); emit8(0xC2); // cmovcc eax, edx
+                emit_chain_dynamic();
+                break;
+            case 0x6000: // 6xnn: LD Vx, byte
+                store_imm8(off_V(x), nn);
+                break;
+            case 0x7000: // 7xnn: ADD Vx, byte
+                emit8(0x80); MODRM_RBX(0); emit32(off_V(x)); emit8(nn); // add byte [Vx], nn
+                break;
+            case 0x8000:
+                switch (n) {
+                    case 0x0: // LD Vx, Vy
+                        load_eax(off_V(y)); store_al(off_V(x)); store_imm8(VF, 0);
+                        break;
+                    case 0x1: case 0x2: case 0x3: { // OR / AND / XOR
+                        static const uint8_t ALU_OPS[4] = {0x00, 0x09, 0x21, 0x31};
+                        load_eax(off_V(x)); load_ecx(off_V(y));
+                        emit8(ALU_OPS[n]); emit8(0xC8);         // op eax, ecx
+                        store_al(off_V(x)); store_imm8(VF, 0);
+                        break;
+                    }
+                    case 0x4: // ADD Vx, Vy (VF = carry)
+                        load_eax(off_V(x)); load_ecx(off_V(y));
+                        emit8(0x01); emit8(0xC8);               // add eax, ecx
+                        emit8(0x89); emit8(0xC2);               // mov edx, eax
+                        emit8(0xC1); emit8(0xEA); emit8(8);     // shr edx, 8
+                        store_dl(VF); store_al(off_V(x));
+                        break;
+                    case 0x5: case 0x7: { // SUB / SUBN (VF = sem borrow)
+                        int32_t a = (n == 0x5) ? off_V(x) : off_V(y);
+                        int32_t b = (n == 0x5) ? off_V(y) : off_V(x);
+                        load_eax(a); load_ecx(b);
+                        emit8(0x39); emit8(0xC8);               // cmp eax, ecx
+                        emit8(0x0F); emit8(0x93); emit8(0xC2);  // setae dl
+                        store_dl(VF);
+                        load_eax(a); load_ecx(b);
+                        emit8(0x29); emit8(0xC8);               // sub eax, ecx
+                        store_al(off_V(x));
+                        break;
+                    }
+                    case 0x6: // SHR Vx
+                        load_eax(off_V(x));
+                        emit8(0x83); emit8(0xE0); emit8(0x01);  // and eax, 1
+                        store_al(VF);
+                        load_eax(off_V(x));
+                        emit8(0xD1); emit8(0xE8);               // shr eax, 1
+                        store_al(off_V(x));
+                        break;
+                    default: // 0xE: SHL Vx
+                        load_eax(off_V(x));
+                        emit8(0xC1); emit8(0xE8); emit8(7);     // shr eax, 7
+                        store_al(VF);
+                        load_eax(off_V(x));
+                        emit8(0xD1); emit8(0xE0);               // shl eax, 1
+                        store_al(off_V(x));
+                        break;
+                }
+                break;
+            case 0xA000: // Annn: LD I, addr
+                emit8(0x66); emit8(0xC7); MODRM_RBX(0); emit32(off_i); emit16(nnn);
+                break;
+            case 0xB000: // Bnnn: JP V0, addr
+                load_eax(off_V(0));
+                emit8(0x05); emit32(nnn);                       // add eax, nnn
+                emit_chain_dynamic();
+                break;
+            default: // 0xF000
+                switch (nn) {
+                    case 0x07: // LD Vx, DT
+                        load_eax(off_delay_timer); store_al(off_V(x));
+                        break;
+                    case 0x15: // LD DT, Vx
+                        load_eax(off_V(x)); store_al(off_delay_timer);
+                        break;
+                    case 0x1E: // ADD I, Vx
+                        load_eax(off_V(x));
+                        emit8(0x66); emit8(0x01); MODRM_RBX(0); emit32(off_i); // add word [I], ax
+                        break;
+                    case 0x29: // LD F, Vx
+                        load_eax(off_V(x));
+                        emit8(0x8D); emit8(0x04); emit8(0x80);  // lea eax, [rax + rax*4]
+                        emit8(0x66); emit8(0x89); MODRM_RBX(0); emit32(off_i); // mov word [I], ax
+                        break;
+                    default: // 0x65: LD Vx, [I]
+                        emit8(0x0F); emit8(0xB7); MODRM_RBX(0); emit32(off_i); // movzx eax, word [I]
+                        // Endereço com a mesma máscara do interpretador ((I + i) & 0xFFF no clássico)
+                        for (uint8_t i = 0; i <= x; ++i) {
+                            emit8(0x8D); emit8(0x48); emit8(i);         // lea ecx, [rax + i]
+                            emit8(0x81); emit8(0xE1); emit32(0xFFF);    // and ecx, 0xFFF
+                            emit8(0x0F); emit8(0xB6); emit8(0x8C); emit8(0x0B); emit32(off_memory); // movzx ecx, byte [rbx+rcx+mem]
+                            emit8(0x88); MODRM_RBX(1); emit32(off_V(i)); // mov [Vi], cl
+                        }
+                        emit8(0x66); emit8(0x81); MODRM_RBX(0); emit32(off_i); emit16(x + 1); // add word [I], x+1
+                        break;
+                }
+                break;
+        }
+    }
+
+    // Bloco interrompido por instrução não traduzível: segue para ela pelo slot da tabela
+    if (!terminated) {
+        emit_chain_static(pc);
+    }
+
+    block_table[start] = block_code;
+    block_length[start] = (uint8_t)count;
+    blocks.push_back({start, pc});
+    for (uint16_t addr = start; addr < pc; ++addr) covered.set(addr);
+    blocks_compiled++;
+    return true;
+}
+
+#undef MODRM_RBX
+
+// =====================================================================
+// DESPACHO E INVALIDAÇÃO
+// =====================================================================
+
+uint32_t JitCompiler::run(uint32_t max_cycles) {
+    const int32_t budget = (int32_t)std::min<uint32_t>(max_cycles, INT32_MAX);
+    int32_t remaining = budget;
+
+    while (remaining > 0) {
+        uint16_t pc = chip.PC & 0xFFF;
+        if (block_length[pc] == 0 && !not_compilable[pc] && ++hit_count[pc] >= JIT_HOT_THRESHOLD) {
+            compile(pc);
+        }
+        if (block_length[pc] != 0 && remaining >= block_length[pc]) {
+            int32_t left = entry(&chip, block_table[pc], remaining);
+            if (left != remaining) {
+                native_cycles += (uint64_t)(remaining - left);
+                remaining = left;
+                continue;
+            }
+            // Nenhum progresso (ex.: CALL com a stack cheia): o interpretador trata
+        }
+        remaining -= (int32_t)chip.interpret_cycles(1);
+        if (chip.m_is_waiting_for_key || chip.idle_loop_hit || chip.sound_timer_written || chip.faulted) break;
+    }
+    return (uint32_t)(budget - remaining);
+}
+
+void JitCompiler::invalidate(uint16_t address, uint16_t length) {
+    if (!code_buffer) return;
+    uint32_t lo = (address == 0) ? 0 : address - 1u;
+    uint32_t hi = std::min<uint32_t>((uint32_t)address + length, 4096);
+
+    bool hit = false;
+    for (uint32_t addr = lo; addr < hi; ++addr) {
+        // O código mudou: permite recompilar/recontar estes endereços
+        not_compilable.reset(addr);
+        hit_count[addr] = 0;
+        hit = hit || covered[addr];
+    }
+    if (!hit) return;
+
+    for (size_t i = 0; i < blocks.size();) {
+        const Block& block = blocks[i];
+        if (block.start < hi && block.end > lo) {
+            block_table[block.start] = exit_stub;
+            block_length[block.start] = 0;
+            blocks_invalidated++;
+            blocks[i] = blocks.back();
+            blocks.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef JITCOMPILER_H
+#define JITCOMPILER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <bitset>
+
+class Chip8;
+
+// Recompilador dinâmico x86-64 para blocos básicos "quentes" do Chip-8.
+// Cada bloco (sequência linear terminada em salto/chamada/retorno/skip) é traduzido
+// para código nativo num cache executável. Os blocos encadeiam entre si pela tabela
+// de blocos (indexada pelo PC) sem voltar ao despachante; instruções não traduzidas
+// (DXYN, FX33, FX55, teclado, ...) são executadas pelo interpretador (fallback).
+class JitCompiler {
+public:
+    explicit JitCompiler(Chip8& chip);
+    ~JitCompiler();
+
+    // true se o host é x86-64 (caso contrário apenas o interpretador é usado)
+    static bool is_supported();
+    bool is_ready() const { return code_buffer != nullptr; }
+
+    // Executa até max_cycles instruções (nativas ou interpretadas). Retorna as executadas.
+    uint32_t run(uint32_t max_cycles);
+
+    // Descarta os blocos que cobrem [address - 1, address + length) (escritas de FX33/FX55)
+    void invalidate(uint16_t address, uint16_t length);
+    void flush(); // Descarta todo o cache de código
+
+    // Estatísticas
+    uint32_t get_blocks_compiled() const { return blocks_compiled; }
+    uint32_t get_blocks_invalidated() const { return blocks_invalidated; }
+    uint64_t get_native_cycles() const { return native_cycles; }
+
+private:
+    struct Block {
+        uint16_t start; // Endereço da primeira instrução
+        uint16_t end;   // Endereço após o último byte traduzido
+    };
+
+    // Assinatura do trampolim de entrada: (vm, código, orçamento) -> orçamento restante
+    using EntryFn = int32_t (*)(Chip8*, const void*, int32_t);
+
+    bool compile(uint16_t start);
+    void emit_entry_and_exit();
+
+    // --- Emissão de bytes ---
+    void emit8(uint8_t value);
+    void emit16(uint16_t value);
+    void emit32(uint32_t value);
+    void emit64(uint64_t value);
+    void emit_jump_to(uint8_t* target);   // jmp rel32
+    void emit_jcc_to(uint8_t cc, uint8_t* target); // jcc rel32
+    void emit_chain_static(uint16_t target_pc);
+    void emit_chain_dynamic();
+    void emit_bail(uint16_t pc, uint32_t refund);
+
+    // Deslocamentos (a partir de rbx = Chip8*)
+    int32_t off_V(uint8_t index) const { return off_v + index; }
+    int32_t off_v, off_i, off_pc, off_sp, off_stack, off_memory, off_delay_timer;
+
+    Chip8& chip;
+    uint8_t* code_buffer;
+    size_t code_capacity;
+    uint8_t* code_ptr;
+    uint8_t* exit_stub; // Grava PC (eax) e retorna ao despachante
+    EntryFn entry;
+
+    std::array<const void*, 4096> block_table; // PC -> código nativo (ou exit_stub)
+    std::array<uint8_t, 4096> block_length;    // Instruções do bloco (0 = não compilado)
+    std::array<uint16_t, 4096> hit_count;      // Contadores de "calor" por endereço
+    std::bitset<4096> not_compilable;          // Endereços cuja 1ª instrução não é traduzível
+    std::bitset<4096> covered;                 // Bytes cobertos por algum bloco
+    std::vector<Block> blocks;
+
+    uint32_t blocks_compiled;
+    uint32_t blocks_invalidated;
+    uint64_t native_cycles;
+};
+
+#endif // JITCOMPILER_H
@@ -0,0 +1,230 @@
+#include "library/Inflate.h"
+#include <cstring>
+
+namespace {
+
+// Tabelas de comprimento/distância da RFC 1951 (seção 3.2.5)
+const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                    8193, 12289, 16385, 24577};
+const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+const uint8_t CODE_LENGTH_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+constexpr int MAX_BITS = 15;
+
+// Código de Huffman canônico: quantidade de códigos por comprimento e símbolos
+// ordenados por código (decodificação bit a bit, suficiente para ROMs de poucos KB)
+struct Huffman {
+    uint16_t count[MAX_BITS + 1];
+    uint16_t symbol[288];
+};
+
+struct Inflater {
+    const uint8_t* in;
+    size_t in_size;
+    size_t in_pos;
+    uint32_t bit_buffer;
+    int bit_count;
+    uint8_t* out;
+    size_t out_size;
+    size_t out_pos;
+    bool error;
+
+    int bits(int need) {
+        uint32_t value = bit_buffer;
+        while (bit_count < need) {
+            if (in_pos >= in_size) {
+                error = true;
+                return 0;
+            }
+            value |= (uint32_t)in[in_pos++] << bit_count;
+            bit_count += 8;
+        }
+        bit_buffer = value >> need;
+        bit_count -= need;
+        return (int)(value & ((1u << need) - 1));
+    }
+
+    int decode(const Huffman& huffman) {
+        int code = 0, first = 0, index = 0;
+        for (int length = 1; length <= MAX_BITS; ++length) {
+            code |= bits(1);
+            if (error) return -1;
+            int count = huffman.count[length];
+            if (code - count < first) return huffman.symbol[index + (code - first)];
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        error = true;
+        return -1;
+    }
+
+    bool stored() {
+        bit_buffer = 0; // Descarta os bits até o limite do byte
+        bit_count = 0;
+        if (in_pos + 4 > in_size) return false;
+        uint32_t length = in[in_pos] | (in[in_pos + 1] << 8);
+        uint32_t complement = in[in_pos + 2] | (in[in_pos + 3] << 8);
+        in_pos += 4;
+        if (length != (~complement & 0xFFFF) || in_pos + length > in_size || out_pos + length > out_size) return false;
+        std::memcpy(out + out_pos, in + in_pos, length);
+        in_pos += length;
+        out_pos += length;
+        return true;
+    }
+
+    bool codes(const Huffman& lengths, const Huffman& distances) {
+        for (;;) {
+            int symbol = decode(lengths);
+            if (symbol < 0) return false;
+            if (symbol < 256) {
+                if (out_pos >= out_size) return false;
+                out[out_pos++] = (uint8_t)symbol;
+            } else if (symbol == 256) {
+                return true; // Fim do bloco
+            } else {
+                symbol -= 257;
+                if (symbol >= 29) return false;
+                size_t length = LENGTH_BASE[symbol] + bits(LENGTH_EXTRA[symbol]);
+                int distance_symbol = decode(distances);
+                if (distance_symbol < 0 || distance_symbol >= 30) return false;
+                size_t distance = DISTANCE_BASE[distance_symbol] + bits(DISTANCE_EXTRA[distance_symbol]);
+                if (error || distance > out_pos || out_pos + length > out_size) return false;
+                for (size_t i = 0; i < length; ++i, ++out_pos) {
+                    out[out_pos] = out[out_pos - distance]; // Pode sobrepor (distance < length)
+                }
+            }
+        }
+    }
+};
+
+// Monta o código a partir dos comprimentos; false se o código for excessivo (inválido)
+bool build(Huffman& huffman, const uint8_t* lengths, int symbol_count) {
+    std::memset(huffman.count, 0, sizeof(huffman.count));
+    for (int symbol = 0; symbol < symbol_count; ++symbol) huffman.count[lengths[symbol]]++;
+    if (huffman.count[0] == symbol_count) return true; // Sem códigos (só permitido sem uso)
+
+    int left = 1;
+    for (int length = 1; length <= MAX_BITS; ++length) {
+        left <<= 1;
+        left -= huffman.count[length];
+        if (left < 0) return false;
+    }
+
+    uint16_t offsets[MAX_BITS + 1];
+    offsets[1] = 0;
+    for (int length = 1; length < MAX_BITS; ++length) {
+        offsets[length + 1] = offsets[length] + huffman.count[length];
+    }
+    for (int symbol = 0; symbol < symbol_count; ++symbol) {
+        if (lengths[symbol] != 0) huffman.symbol[offsets[lengths[symbol]]++] = (uint16_t)symbol;
+    }
+    return true;
+}
+
+// Códigos fixos (bloco tipo 1), montados uma vez (static local: seguro entre threads)
+struct FixedCodes {
+    Huffman lengths, distances;
+    FixedCodes() {
+        uint8_t code_lengths[288];
+        int symbol = 0;
+        for (; symbol < 144; ++symbol) code_lengths[symbol] = 8;
+        for (; symbol < 256; ++symbol) code_lengths[symbol] = 9;
+        for (; symbol < 280; ++symbol) code_lengths[symbol] = 7;
+        for (; symbol < 288; ++symbol) code_lengths[symbol] = 8;
+        build(lengths, code_lengths, 288);
+        for (symbol = 0; symbol < 30; ++symbol) code_lengths[symbol] = 5;
+        build(distances, code_lengths, 30);
+    }
+};
+
+bool fixed_block(Inflater& inflater) {
+    static const FixedCodes codes;
+    return inflater.codes(codes.lengths, codes.distances);
+}
+
+bool dynamic_block(Inflater& inflater) {
+    int length_count = inflater.bits(5) + 257;
+    int distance_count = inflater.bits(5) + 1;
+    int code_count = inflater.bits(4) + 4;
+    if (inflater.error || length_count > 286 || distance_count > 30) return false;
+
+    uint8_t lengths[286 + 30] = {};
+    for (int i = 0; i < code_count; ++i) lengths[CODE_LENGTH_ORDER[i]] = (uint8_t)inflater.bits(3);
+    Huffman code_lengths;
+    if (inflater.error || !build(code_lengths, lengths, 19)) return false;
+
+    // Comprimentos dos códigos literal/comprimento e distância, com repetições (16-18)
+    int index = 0;
+    std::memset(lengths, 0, sizeof(lengths));
+    while (index < length_count + distance_count) {
+        int symbol = inflater.decode(code_lengths);
+        if (symbol < 0) return false;
+        if (symbol < 16) {
+            lengths[index++] = (uint8_t)symbol;
+            continue;
+        }
+        uint8_t value = 0;
+        int repeat;
+        if (symbol == 16) {
+            if (index == 0) return false;
+            value = lengths[index - 1];
+            repeat = 3 + inflater.bits(2);
+        } else if (symbol == 17) {
+            repeat = 3 + inflater.bits(3);
+        } else {
+            repeat = 11 + inflater.bits(7);
+        }
+        if (inflater.error || index + repeat > length_count + distance_count) return false;
+        while (repeat--) lengths[index++] = value;
+    }
+    if (lengths[256] == 0) return false; // Sem código de fim de bloco
+
+    Huffman literal_codes, distance_codes;
+    if (!build(literal_codes, lengths, length_count)) return false;
+    if (!build(distance_codes, lengths + length_count, distance_count)) return false;
+    return inflater.codes(literal_codes, distance_codes);
+}
+
+} // namespace
+
+long inflate_raw(const uint8_t* in, size_t in_size, uint8_t* out, size_t out_size) {
+    Inflater inflater{in, in_size, 0, 0, 0, out, out_size, 0, false};
+    int last;
+    do {
+        last = inflater.bits(1);
+        int type = inflater.bits(2);
+        if (inflater.error) return -1;
+        bool ok = false;
+        if (type == 0) ok = inflater.stored();
+        else if (type == 1) ok = fixed_block(inflater);
+        else if (type == 2) ok = dynamic_block(inflater);
+        if (!ok || inflater.error) return -1;
+    } while (!last);
+    return (long)inflater.out_pos;
+}
+
+struct CrcTable {
+    uint32_t entries[256];
+    CrcTable() {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            entries[n] = c;
+        }
+    }
+};
+
+uint32_t crc32(const uint8_t* data, size_t size) {
+    static const CrcTable table;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) crc = table.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
@@ -0,0 +1,15 @@
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Descompressor DEFLATE (RFC 1951, método 8 do zip) sem dependências externas.
+// Escreve direto no destino (ex.: a memória da VM), sem buffer intermediário.
+// Retorna os bytes gerados ou -1 se o fluxo for inválido ou não couber em out_size.
+long inflate_raw(const uint8_t* in, size_t in_size, uint8_t* out, size_t out_size);
+
+// CRC-32 (polinômio do zip/zlib)
+uint32_t crc32(const uint8_t* data, size_t size);
+
+#endif // INFLATE_H
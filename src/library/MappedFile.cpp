@@ -0,0 +1,68 @@
+#include "library/MappedFile.h"
+#include <fstream>
+#include <iostream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "ERRO: Nao foi possivel abrir o arquivo: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        std::cerr << "ERRO: Nao foi possivel ler o tamanho do arquivo: " << path << std::endl;
+        return false;
+    }
+    size = (size_t)info.st_size;
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            size = 0;
+            std::cerr << "ERRO: Falha ao mapear o arquivo em memoria: " << path << std::endl;
+            return false;
+        }
+        data = (const uint8_t*)mapping;
+    }
+    ::close(fd); // O mapeamento continua válido sem o descritor
+    return true;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel abrir o arquivo: " << path << std::endl;
+        return false;
+    }
+    fallback.resize((size_t)file.tellg());
+    file.seekg(0, std::ios::beg);
+    if (!file.read((char*)fallback.data(), fallback.size())) {
+        std::cerr << "ERRO: Falha ao ler o arquivo: " << path << std::endl;
+        fallback.clear();
+        return false;
+    }
+    data = fallback.data();
+    size = fallback.size();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (data && fallback.empty()) munmap((void*)data, size);
+#endif
+    fallback.clear();
+    data = nullptr;
+    size = 0;
+}
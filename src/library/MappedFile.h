@@ -0,0 +1,30 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Arquivo somente leitura mapeado em memória (mmap). Em hosts sem mmap o
+// conteúdo é lido para um buffer. Não copiável; o mapeamento dura até o destrutor.
+class MappedFile {
+public:
+    MappedFile() : data(nullptr), size(0) {}
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path); // false (com mensagem em std::cerr) se falhar
+    void close();
+
+    const uint8_t* get_data() const { return data; }
+    size_t get_size() const { return size; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    std::vector<uint8_t> fallback; // Conteúdo lido (sem mmap)
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,257 @@
+#include "library/RomLibrary.h"
+#include "library/Inflate.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+// Assinaturas e tamanhos fixos do formato zip (APPNOTE.TXT)
+constexpr uint32_t ZIP_LOCAL_HEADER = 0x04034b50;
+constexpr uint32_t ZIP_CENTRAL_HEADER = 0x02014b50;
+constexpr uint32_t ZIP_END_OF_DIRECTORY = 0x06054b50;
+constexpr size_t ZIP_LOCAL_HEADER_SIZE = 30;
+constexpr size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+constexpr size_t ZIP_END_SIZE = 22;
+
+static uint16_t read16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t read32(const uint8_t* p) { return (uint32_t)read16(p) | ((uint32_t)read16(p + 2) << 16); }
+
+static uint64_t content_hash(const uint8_t* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static bool is_zip_path(const std::string& path) {
+    std::string extension = fs::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".zip";
+}
+
+bool RomLibrary::add_path(const std::string& path) {
+    std::error_code error;
+    if (fs::is_directory(path, error)) {
+        std::vector<fs::path> files;
+        for (const fs::directory_entry& entry : fs::directory_iterator(path, error)) {
+            if (entry.is_regular_file()) files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+        for (const fs::path& file : files) add_file(file.string());
+        return true;
+    }
+    return add_file(path);
+}
+
+bool RomLibrary::add_file(const std::string& path) {
+    std::error_code error;
+    uint64_t file_size = fs::file_size(path, error);
+    if (error) {
+        std::cerr << "ERRO: Nao foi possivel abrir o arquivo: " << path << std::endl;
+        return false;
+    }
+    bool zip = is_zip_path(path);
+    if (!zip && (file_size == 0 || file_size > max_rom_size)) {
+        std::cerr << "AVISO: ignorando '" << path << "' (nao e uma ROM valida)." << std::endl;
+        return false;
+    }
+
+    Source source;
+    source.path = path;
+    source.file_size = file_size;
+    source.modified = (int64_t)fs::last_write_time(path, error).time_since_epoch().count();
+    source.file.reset(new MappedFile());
+    if (!source.file->open(path)) return false;
+    sources.push_back(std::move(source));
+    uint32_t index = (uint32_t)(sources.size() - 1);
+
+    if (add_from_cache(index)) return true;
+    if (zip) return add_zip(index);
+
+    const MappedFile& file = *sources[index].file;
+    add_entry({path, index, 0, (uint32_t)file.get_size(), (uint32_t)file.get_size(), 0, 0,
+               content_hash(file.get_data(), file.get_size()), false});
+    return true;
+}
+
+bool RomLibrary::add_zip(uint32_t source_index) {
+    const Source& source = sources[source_index];
+    const uint8_t* data = source.file->get_data();
+    const size_t size = source.file->get_size();
+
+    // Fim do diretório central: últimos 22 bytes + comentário de até 64 KB
+    if (size < ZIP_END_SIZE) {
+        std::cerr << "ERRO: Arquivo zip invalido: " << source.path << std::endl;
+        return false;
+    }
+    size_t end = size - ZIP_END_SIZE;
+    const size_t search_limit = size > ZIP_END_SIZE + 0xFFFF ? size - ZIP_END_SIZE - 0xFFFF : 0;
+    while (read32(data + end) != ZIP_END_OF_DIRECTORY) {
+        if (end == search_limit) {
+            std::cerr << "ERRO: Arquivo zip invalido (sem diretorio central): " << source.path << std::endl;
+            return false;
+        }
+        --end;
+    }
+    uint16_t entry_count = read16(data + end + 10);
+    size_t position = read32(data + end + 16);
+
+    std::vector<uint8_t> rom(max_rom_size);
+    for (uint16_t i = 0; i < entry_count; ++i) {
+        if (position + ZIP_CENTRAL_HEADER_SIZE > size || read32(data + position) != ZIP_CENTRAL_HEADER) {
+            std::cerr << "ERRO: Diretorio central corrompido: " << source.path << std::endl;
+            return false;
+        }
+        const uint8_t* header = data + position;
+        uint16_t method = read16(header + 10);
+        uint32_t crc = read32(header + 16);
+        uint32_t stored_size = read32(header + 20);
+        uint32_t rom_size = read32(header + 24);
+        uint16_t name_length = read16(header + 28);
+        size_t local_offset = read32(header + 42);
+        size_t next = position + ZIP_CENTRAL_HEADER_SIZE + name_length + read16(header + 30) + read16(header + 32);
+        if (next > size) {
+            std::cerr << "ERRO: Diretorio central corrompido: " << source.path << std::endl;
+            return false;
+        }
+        std::string entry_name((const char*)header + ZIP_CENTRAL_HEADER_SIZE, name_length);
+        position = next;
+
+        if (entry_name.empty() || entry_name.back() == '/') continue; // Diretório
+        std::string name = source.path + ":" + entry_name;
+        if ((method != 0 && method != 8) || rom_size == 0 || rom_size > max_rom_size) {
+            std::cerr << "AVISO: ignorando '" << name << "' (nao e uma ROM valida ou compressao nao suportada)." << std::endl;
+            continue;
+        }
+
+        // Os dados começam depois do cabeçalho local (nome e extra podem diferir do central)
+        if (local_offset + ZIP_LOCAL_HEADER_SIZE > size || read32(data + local_offset) != ZIP_LOCAL_HEADER) {
+            std::cerr << "AVISO: ignorando '" << name << "' (cabecalho local invalido)." << std::endl;
+            continue;
+        }
+        uint64_t data_offset = local_offset + ZIP_LOCAL_HEADER_SIZE
+                             + read16(data + local_offset + 26) + read16(data + local_offset + 28);
+        RomEntry entry{name, source_index, data_offset, stored_size, rom_size, method, crc, 0, true};
+
+        // Descomprime uma vez para calcular o hash do conteúdo (e validar a entrada)
+        if (!read(entry, rom.data(), rom.size())) {
+            std::cerr << "AVISO: ignorando '" << name << "' (dados corrompidos)." << std::endl;
+            continue;
+        }
+        entry.hash = content_hash(rom.data(), rom_size);
+        add_entry(entry);
+    }
+    return true;
+}
+
+void RomLibrary::add_entry(RomEntry entry) {
+    hash_index.emplace(entry.hash, entries.size()); // Mantém a primeira ocorrência
+    entries.push_back(std::move(entry));
+}
+
+bool RomLibrary::read(const RomEntry& entry, uint8_t* dest, size_t capacity) const {
+    const MappedFile& file = *sources[entry.source].file;
+    if (entry.size > capacity || entry.data_offset + entry.stored_size > file.get_size()) return false;
+    const uint8_t* data = file.get_data() + entry.data_offset;
+
+    if (entry.method == 0) {
+        if (entry.stored_size != entry.size) return false;
+        std::memcpy(dest, data, entry.size);
+    } else if (inflate_raw(data, entry.stored_size, dest, entry.size) != (long)entry.size) {
+        return false;
+    }
+    return !entry.in_archive || crc32(dest, entry.size) == entry.crc;
+}
+
+const RomEntry* RomLibrary::find_by_name(const std::string& name) const {
+    for (const RomEntry& entry : entries) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+const RomEntry* RomLibrary::find_by_hash(uint64_t hash) const {
+    auto found = hash_index.find(hash);
+    return found != hash_index.end() ? &entries[found->second] : nullptr;
+}
+
+// --- Cache em disco ---
+// Texto, uma ROM por linha, campos separados por tabulação:
+// origem, tamanho da origem, data de modificação, nome, offset, bytes armazenados,
+// tamanho, método, crc, hash (hex)
+
+bool RomLibrary::add_from_cache(uint32_t source_index) {
+    const Source& source = sources[source_index];
+    bool found = false;
+    for (const CachedEntry& cached : cache) {
+        if (cached.source_path != source.path || cached.file_size != source.file_size
+            || cached.modified != source.modified) {
+            continue;
+        }
+        if (cached.entry.data_offset + cached.entry.stored_size > source.file->get_size()) return false;
+        RomEntry entry = cached.entry;
+        entry.source = source_index;
+        add_entry(entry);
+        found = true;
+    }
+    return found;
+}
+
+bool RomLibrary::load_cache(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return true; // Primeira execução: o cache será criado
+
+    cache.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        CachedEntry cached;
+        std::string source_size, modified, offset, stored, size, method, crc, hash;
+        if (!std::getline(fields, cached.source_path, '\t') || !std::getline(fields, source_size, '\t')
+            || !std::getline(fields, modified, '\t') || !std::getline(fields, cached.entry.name, '\t')
+            || !std::getline(fields, offset, '\t') || !std::getline(fields, stored, '\t')
+            || !std::getline(fields, size, '\t') || !std::getline(fields, method, '\t')
+            || !std::getline(fields, crc, '\t') || !std::getline(fields, hash, '\t')) {
+            continue; // Linha incompleta: a fonte será reprocessada
+        }
+        try {
+            cached.file_size = std::stoull(source_size);
+            cached.modified = std::stoll(modified);
+            cached.entry.data_offset = std::stoull(offset);
+            cached.entry.stored_size = (uint32_t)std::stoul(stored);
+            cached.entry.size = (uint32_t)std::stoul(size);
+            cached.entry.method = (uint16_t)std::stoul(method);
+            cached.entry.crc = (uint32_t)std::stoul(crc);
+            cached.entry.hash = std::stoull(hash, nullptr, 16);
+        } catch (const std::exception&) {
+            continue;
+        }
+        if ((cached.entry.method != 0 && cached.entry.method != 8) || cached.entry.size > max_rom_size) continue;
+        cached.entry.source = 0;
+        cached.entry.in_archive = cached.entry.name != cached.source_path;
+        cache.push_back(std::move(cached));
+    }
+    return true;
+}
+
+bool RomLibrary::save_cache(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel gravar o cache de ROMs: " << path << std::endl;
+        return false;
+    }
+    for (const RomEntry& entry : entries) {
+        const Source& source = sources[entry.source];
+        file << source.path << '\t' << source.file_size << '\t' << source.modified << '\t'
+             << entry.name << '\t' << entry.data_offset << '\t' << entry.stored_size << '\t'
+             << entry.size << '\t' << entry.method << '\t' << entry.crc << '\t'
+             << std::hex << entry.hash << std::dec << '\n';
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef ROMLIBRARY_H
+#define ROMLIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "library/MappedFile.h"
+
+// Maior ROM que cabe na memória de 4 KB a partir de 0x200 (limite padrão da biblioteca;
+// o XO-CHIP passa memory_size() - 0x200 ao construtor)
+constexpr size_t MAX_LIBRARY_ROM_SIZE = 4096 - 0x200;
+
+// Uma ROM da biblioteca: arquivo solto ou entrada de um .zip
+struct RomEntry {
+    std::string name;        // "roms/PONG" ou "roms/c8games.zip:PONG"
+    uint32_t source;         // Índice do arquivo de origem (mapeado)
+    uint64_t data_offset;    // Início dos dados no arquivo de origem
+    uint32_t stored_size;    // Bytes no arquivo (comprimidos se method == 8)
+    uint32_t size;           // Bytes da ROM
+    uint16_t method;         // 0 = armazenado, 8 = deflate
+    uint32_t crc;            // CRC-32 do zip (0 em arquivos soltos)
+    uint64_t hash;           // FNV-1a 64 do conteúdo: identidade da ROM
+    bool in_archive;         // Entrada de .zip (confere o CRC ao ler)
+};
+
+// Biblioteca de ROMs: arquivos soltos, diretórios e arquivos .zip mapeados em
+// memória. Cada ROM é indexada pelo hash do conteúdo; read() escreve a ROM
+// direto no destino (memória da VM), descomprimindo do mapeamento sem buffers
+// intermediários. Depois de montada, leituras concorrentes são seguras.
+//
+// O índice pode ser guardado em um cache em disco: fontes com o mesmo caminho,
+// tamanho e data de modificação não são reprocessadas (sem descompressão nem hash).
+class RomLibrary {
+public:
+    explicit RomLibrary(size_t max_rom_size = MAX_LIBRARY_ROM_SIZE) : max_rom_size(max_rom_size) {}
+
+    bool add_path(const std::string& path);      // Arquivo, .zip ou diretório (não recursivo)
+    bool load_cache(const std::string& path);    // Cache ausente não é erro
+    bool save_cache(const std::string& path) const;
+
+    const std::vector<RomEntry>& get_entries() const { return entries; }
+    const RomEntry* find_by_name(const std::string& name) const;
+    const RomEntry* find_by_hash(uint64_t hash) const;
+
+    // Copia/descomprime a ROM para dest (capacity bytes) e confere o CRC do zip
+    bool read(const RomEntry& entry, uint8_t* dest, size_t capacity) const;
+
+private:
+    struct Source {
+        std::string path;
+        uint64_t file_size;
+        int64_t modified;    // Data de modificação (para validar o cache)
+        std::unique_ptr<MappedFile> file;
+    };
+    struct CachedEntry {
+        std::string source_path;
+        uint64_t file_size;
+        int64_t modified;
+        RomEntry entry;
+    };
+
+    bool add_file(const std::string& path);
+    bool add_zip(uint32_t source_index);
+    bool add_from_cache(uint32_t source_index);
+    void add_entry(RomEntry entry);
+
+    size_t max_rom_size; // Entradas maiores que a memória da máquina são ignoradas
+    std::vector<Source> sources;
+    std::vector<RomEntry> entries;
+    std::unordered_map<uint64_t, size_t> hash_index; // Hash -> primeira entrada com o conteúdo
+    std::vector<CachedEntry> cache;
+};
+
+#endif // ROMLIBRARY_H
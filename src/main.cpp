@@ -1,24 +1,74 @@
 #include <iostream>
+#ifndef CHIP8_HEADLESS
 #include <SDL3/SDL.h> 
-#include <chrono>   
-#include <thread>   
+#endif
 #include <algorithm>
+#include <atomic>
 #include <cstring>  
+#include <ctime>
 #include <iomanip> 
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 #include "Chip8.h"    
+#include "Headless.h"
+#include "Log.h"
+#include "ExecutionTrace.h"
+#include "Profiler.h"
+#include "SaveState.h"
+#include "RewindBuffer.h"
+#include "InputRecording.h"
+#include "WavWriter.h"
+#include "FrameScheduler.h"
+#include "aot/AotProgram.h"
+#include "InputQueue.h"
+#include "LatencyMeter.h"
+#include "TripleBuffer.h"
 #include "components/Display.h"
 
-using namespace std::chrono;
-
 // Constantes de Timing
 constexpr int DEFAULT_CPU_HZ = 500;
 constexpr int PERIPHERAL_HZ = 60;
-constexpr auto US_PER_60HZ_CYCLE = duration_cast<microseconds>(seconds(1)) / PERIPHERAL_HZ;
+constexpr uint32_t MAX_CATCH_UP_FRAMES = 4; // Quadros atrasados emulados de uma vez após um travamento
+constexpr uint32_t REWIND_FRAMES_PER_TICK = 2; // Backspace volta no tempo a 2x a velocidade normal
+constexpr uint32_t TURBO_UNCAPPED = 0;         // Velocidade do turbo sem limite (--turbo max)
 
 // Constante para o Fator de Escala
 constexpr uint32_t DEFAULT_SCALE = 10;
 uint32_t scale_factor = DEFAULT_SCALE; // Variável global (ou estática) para armazenar o fator de escala
 
+// Modo headless: sem SDL, velocidade máxima, encerra por orçamento de ciclos/quadros.
+// O target chip8_headless é compilado sem SDL e roda sempre neste modo.
+#ifdef CHIP8_HEADLESS
+bool headless_mode = true;
+#else
+bool headless_mode = false;
+#endif
+uint64_t cycle_budget = 0; // --cycles <N> (0 = sem limite)
+uint64_t frame_budget = 0; // --frames <N> (0 = sem limite)
+CpuEngine cpu_engine = CpuEngine::Interpreter; // --engine interp|jit|aot
+MachineProfile machine_profile = MachineProfile::Chip8; // --machine chip8|schip|xochip
+const char* input_script_path = nullptr;       // --input <roteiro> (headless)
+const char* trace_path = nullptr;              // --trace <arquivo>: trace binário de execução
+const char* load_state_path = nullptr;         // --load-state <arquivo>: começa a partir de um save state
+const char* save_state_path = nullptr;         // --save-state <arquivo>: grava ao fim (headless) ou com F5
+constexpr const char* DEFAULT_STATE_PATH = "chip8.state"; // F5/F9 sem --save-state
+size_t rewind_bytes = DEFAULT_REWIND_BYTES;   // --rewind <KB>: memória do histórico (0 = desligado)
+bool seed_given = false;                       // --seed <N>: semente explícita do RNG (CXNN)
+uint32_t rng_seed = 0;
+const char* record_path = nullptr;             // --record <arquivo>: grava semente e teclas para replay
+const char* replay_path = nullptr;             // --replay <arquivo>: reexecuta uma gravação (headless)
+const char* profile_path = nullptr;            // --profile <arquivo>: perfil por opcode/endereço (.csv ou .json)
+size_t profile_top = DEFAULT_PROFILE_TOP;      // --profile-top <N>: linhas da tabela de endereços
+bool audio_enabled = true;                     // --audio square|sine|off
+Waveform audio_waveform = Waveform::Square;
+const char* wav_path = nullptr;                // --wav <arquivo>: bipe renderizado em WAV (headless)
+int cpu_core = -1;                             // --cpu-core <N>: fixa a thread da CPU em um núcleo (Linux)
+uint32_t turbo_speed = TURBO_UNCAPPED;         // Velocidade do turbo (Tab): N× ou sem limite
+bool turbo_at_start = false;                   // --turbo <N|max>: começa em turbo
+
 // Função para analisar argumentos e configurar o clock, escala e o caminho da ROM
 uint32_t parse_args(int argc, char* argv[], const char** rom_path, uint32_t default_clock) {
     uint32_t clock_hz = default_clock;
@@ -28,7 +78,7 @@ uint32_t parse_args(int argc, char* argv[], const char** rom_path, uint32_t defa
             try {
                 // Tenta converter o argumento seguinte (i+1) para um inteiro sem sinal
                 clock_hz = std::stoul(argv[++i]);
-                std::cout << "DEBUG: Clock configurado para " << clock_hz << " Hz." << std::endl;
+                LOG_DEBUG("Clock configurado para %u Hz.", clock_hz);
             } catch (const std::exception& e) {
                 // Critério de Aceitação: Tratamento de erro para argumento mal-formatado
                 std::cerr << "ERRO de argumento: --clock invalido ('" << argv[i] << "'). Usando padrao: " << default_clock << " Hz." << std::endl;
@@ -37,12 +87,135 @@ uint32_t parse_args(int argc, char* argv[], const char** rom_path, uint32_t defa
         else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
             try {
                 scale_factor = std::stoul(argv[++i]);
-                std::cout << "DEBUG: Fator de escala configurado para " << scale_factor << "x." << std::endl;
+                LOG_DEBUG("Fator de escala configurado para %ux.", (unsigned)scale_factor);
             } catch (const std::exception& e) {
                 // Critério de Aceitação: Tratamento de erro para argumento mal-formatado
                 std::cerr << "ERRO de argumento: --scale invalido ('" << argv[i] << "'). Usando padrao: " << DEFAULT_SCALE << "x." << std::endl;
             }
         }
+        else if (strcmp(argv[i], "--headless") == 0) {
+            headless_mode = true;
+        }
+        else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+            try {
+                cycle_budget = std::stoull(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "ERRO de argumento: --cycles invalido ('" << argv[i] << "'). Sem limite de ciclos." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            try {
+                frame_budget = std::stoull(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "ERRO de argumento: --frames invalido ('" << argv[i] << "'). Sem limite de quadros." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--log-level") == 0 && i + 1 < argc) {
+            LogLevel level;
+            if (Log::parse_level(argv[++i], &level)) {
+                Log::set_level(level);
+            } else {
+                std::cerr << "ERRO de argumento: --log-level invalido ('" << argv[i] << "'). Usando padrao: info." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--load-state") == 0 && i + 1 < argc) {
+            load_state_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--save-state") == 0 && i + 1 < argc) {
+            save_state_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--rewind") == 0 && i + 1 < argc) {
+            try {
+                rewind_bytes = (size_t)std::stoul(argv[++i]) * 1024;
+            } catch (const std::exception& e) {
+                std::cerr << "ERRO de argumento: --rewind invalido ('" << argv[i] << "'). Usando padrao: " << DEFAULT_REWIND_BYTES / 1024 << " KB." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            try {
+                rng_seed = (uint32_t)std::stoul(argv[++i], nullptr, 0);
+                seed_given = true;
+            } catch (const std::exception& e) {
+                std::cerr << "ERRO de argumento: --seed invalido ('" << argv[i] << "'). Usando semente aleatoria." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+            headless_mode = true;
+        }
+        else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--profile-top") == 0 && i + 1 < argc) {
+            try {
+                profile_top = (size_t)std::stoul(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "ERRO de argumento: --profile-top invalido ('" << argv[i] << "'). Usando padrao: " << DEFAULT_PROFILE_TOP << "." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--audio") == 0 && i + 1 < argc) {
+            ++i;
+            if (strcmp(argv[i], "square") == 0) {
+                audio_waveform = Waveform::Square;
+            } else if (strcmp(argv[i], "sine") == 0) {
+                audio_waveform = Waveform::Sine;
+            } else if (strcmp(argv[i], "off") == 0) {
+                audio_enabled = false;
+            } else {
+                std::cerr << "ERRO de argumento: --audio invalido ('" << argv[i] << "'). Usando padrao: square." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--wav") == 0 && i + 1 < argc) {
+            wav_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--cpu-core") == 0 && i + 1 < argc) {
+            try {
+                cpu_core = std::stoi(argv[++i]);
+            } catch (const std::exception& e) {
+                std::cerr << "ERRO de argumento: --cpu-core invalido ('" << argv[i] << "'). Thread sem afinidade." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--turbo") == 0 && i + 1 < argc) {
+            ++i;
+            turbo_at_start = true;
+            if (strcmp(argv[i], "max") == 0) {
+                turbo_speed = TURBO_UNCAPPED;
+            } else {
+                try {
+                    turbo_speed = std::stoul(argv[i]);
+                } catch (const std::exception& e) {
+                    std::cerr << "ERRO de argumento: --turbo invalido ('" << argv[i] << "'). Usando padrao: max." << std::endl;
+                    turbo_speed = TURBO_UNCAPPED;
+                }
+            }
+        }
+        else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+            input_script_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            ++i;
+            if (strcmp(argv[i], "jit") == 0) {
+                cpu_engine = CpuEngine::Jit;
+            } else if (strcmp(argv[i], "aot") == 0) {
+                cpu_engine = CpuEngine::Aot;
+            } else if (strcmp(argv[i], "interp") == 0) {
+                cpu_engine = CpuEngine::Interpreter;
+            } else {
+                std::cerr << "ERRO de argumento: --engine invalido ('" << argv[i] << "'). Usando padrao: interp." << std::endl;
+            }
+        }
+        else if (strcmp(argv[i], "--machine") == 0 && i + 1 < argc) {
+            ++i;
+            if (!parse_machine_profile(argv[i], machine_profile)) {
+                std::cerr << "ERRO de argumento: --machine invalido ('" << argv[i] << "'). Usando padrao: chip8." << std::endl;
+            }
+        }
         else if (argv[i][0] != '-' || (argv[i][0] == '-' && argv[i][1] != '-')) {
             // Assume que o argumento é o caminho da ROM
             *rom_path = argv[i];
@@ -51,17 +224,338 @@ uint32_t parse_args(int argc, char* argv[], const char** rom_path, uint32_t defa
     return clock_hz;
 }
 
+static void dump_trace(Chip8& emulator) {
+    if (emulator.get_trace()->dump()) {
+        std::cout << "Trace de execucao gravado em " << emulator.get_trace()->get_path() << std::endl;
+    } else {
+        std::cerr << "ERRO: Nao foi possivel gravar o trace em " << emulator.get_trace()->get_path() << std::endl;
+    }
+}
+
+// Relatório do profiler (tabelas no console) e mapa de calor em arquivo
+static void report_profile(const Chip8& emulator) {
+    const Profiler* profiler = emulator.get_profiler();
+    std::cout << "\n=================================================" << std::endl;
+    std::cout << "PERFIL DE EXECUCAO" << std::endl;
+    profiler->print_report(std::cout, profile_top);
+    if (profiler->write_heatmap(profile_path)) {
+        std::cout << "Mapa de calor (4 KB) gravado em " << profile_path << std::endl;
+    }
+    std::cout << "=================================================" << std::endl;
+}
+
+// Fixa a thread atual em um núcleo; sem suporte ou em caso de falha a emulação segue sem afinidade
+static void pin_current_thread(int core) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (error != 0) {
+        std::cerr << "AVISO: Nao foi possivel fixar a thread da CPU no nucleo " << core << ": " << strerror(error) << std::endl;
+        return;
+    }
+    LOG_INFO("Thread da CPU fixada no nucleo %d.", core);
+#else
+    (void)core;
+    std::cerr << "AVISO: --cpu-core so e suportado no Linux. Thread sem afinidade." << std::endl;
+#endif
+}
+
+static bool save_state_to(const Chip8& emulator, const char* path) {
+    SaveState state;
+    emulator.save_state(state);
+    if (!write_save_state(path, state)) return false;
+    std::cout << "Save state gravado em " << path << std::endl;
+    return true;
+}
+
+static bool load_state_from(Chip8& emulator, const char* path) {
+    SaveState state;
+    if (!read_save_state(path, state) || !emulator.load_state(state)) return false;
+    std::cout << "Save state carregado de " << path << std::endl;
+    return true;
+}
+
+#ifndef CHIP8_HEADLESS
+// Destinos das teclas aplicadas pela CPU: gravação para replay e medição de latência
+struct FrameInputContext {
+    InputQueue* queue;
+    InputRecording* recording; // nullptr sem --record
+    LatencyMeter* latency;
+};
+
+static void apply_key(Chip8& emulator, FrameInputContext& context, uint64_t frame, const TimedKeyEvent& event) {
+    uint16_t keys_before = emulator.get_key_mask();
+    emulator.set_key(event.key, event.pressed);
+    if (keys_before == emulator.get_key_mask()) return;
+    if (context.recording) context.recording->record(frame, emulator.get_cycle_count(), event.key, event.pressed);
+    if (event.pressed) context.latency->on_key_applied(event.timestamp_ns, emulator.get_pixel_buffer());
+}
+
+// Aplica as teclas da fila registradas antes de until_ns
+static void apply_due_keys(Chip8& emulator, FrameInputContext& context, uint64_t frame, uint64_t until_ns) {
+    TimedKeyEvent event;
+    while (context.queue->peek(&event) && event.timestamp_ns < until_ns) {
+        context.queue->pop();
+        apply_key(emulator, context, frame, event);
+    }
+}
+
+// Executa um quadro de CPU cobrindo a janela de tempo real [start_ns, end_ns): cada
+// tecla é aplicada no ciclo proporcional ao seu instante, dividindo o lote (um toque
+// mais curto que um quadro ainda é visto pela ROM). As regras seguem o modo headless,
+// para o replay da gravação reproduzir a sessão: parada em FX0A no meio do lote
+// encerra o quadro, e as teclas restantes da janela são aplicadas ao fim dele.
+static uint32_t run_frame_with_input(Chip8& emulator, FrameInputContext& context, uint64_t frame,
+                                     uint32_t frame_cycles, uint64_t start_ns, uint64_t end_ns) {
+    const uint64_t span_ns = end_ns > start_ns ? end_ns - start_ns : 1;
+    auto cycle_of = [&](const TimedKeyEvent& event) {
+        uint64_t offset = event.timestamp_ns > start_ns ? event.timestamp_ns - start_ns : 0;
+        return (uint32_t)(offset * frame_cycles / span_ns);
+    };
+
+    uint32_t executed = 0;
+    TimedKeyEvent event;
+    while (true) {
+        // Teclas cujo ciclo já foi alcançado
+        while (context.queue->peek(&event) && event.timestamp_ns < end_ns && cycle_of(event) <= executed) {
+            context.queue->pop();
+            apply_key(emulator, context, frame, event);
+        }
+        if (executed >= frame_cycles) break;
+        bool pending = context.queue->peek(&event) && event.timestamp_ns < end_ns;
+
+        if (emulator.is_waiting_for_key()) {
+            // Parada em FX0A desde o quadro anterior: a CPU não avança, então a próxima
+            // tecla da janela vale para o ciclo atual
+            if (!pending) break;
+            context.queue->pop();
+            apply_key(emulator, context, frame, event);
+            continue;
+        }
+
+        uint32_t chunk = pending ? cycle_of(event) - executed : frame_cycles - executed;
+        uint32_t ran = emulator.run_cycles(chunk);
+        executed += ran;
+        if (ran < chunk) break; // FX0A: o restante do quadro é perdido
+    }
+    // Depois da parada em FX0A: para o replay valem como teclas do início do próximo quadro
+    apply_due_keys(emulator, context, frame + 1, end_ns);
+    return executed;
+}
+
+// Quadro publicado pela thread da CPU para a janela
+struct PresentedFrame {
+    Framebuffer pixels;
+    uint64_t latency_tag_ns; // Instante da tecla da última mudança de tela medida (0 = nenhuma)
+};
+
+// Estado compartilhado entre a thread da janela (eventos SDL e apresentação) e a
+// thread da CPU, dona do emulador. A janela só empurra teclas na fila e sinaliza
+// pedidos atômicos; a CPU só publica quadros pelo buffer triplo.
+struct EmulationContext {
+    Chip8* emulator;
+    FrameScheduler* scheduler;
+    FrameInputContext* input;
+    RewindBuffer* rewind_buffer;
+    TripleBuffer<PresentedFrame>* frames;
+    const char* state_path;      // F5/F9
+    uint32_t frame_ready_event;  // Evento SDL que acorda a janela quando há quadro novo
+    uint64_t emulated_frames;    // Lido pela janela só depois do join
+    std::atomic<bool> quit{false};
+    std::atomic<bool> rewinding{false};
+    std::atomic<bool> turbo{false};
+    std::atomic<bool> save_requested{false};
+    std::atomic<bool> load_requested{false};
+    std::atomic<bool> dump_requested{false};
+    std::atomic<bool> frame_event_pending{false}; // No máximo um evento de quadro na fila da SDL
+};
+
+// Laço da thread da CPU: emulação em tempo emulado pelo agendador, independente de
+// quanto a apresentação demora (vsync, janela arrastada ou minimizada). Em turbo um
+// lote cobre vários quadros emulados e só o último é publicado: o salto de quadros
+// na apresentação se ajusta sozinho à velocidade alcançada.
+static void run_emulation(EmulationContext* context) {
+    if (cpu_core >= 0) pin_current_thread(cpu_core);
+    Chip8& emulator = *context->emulator;
+    FrameScheduler& scheduler = *context->scheduler;
+    SaveState rewind_state;
+
+    scheduler.start();
+    uint64_t window_start_ns = SDL_GetTicksNS();
+    while (!context->quit.load(std::memory_order_relaxed)) {
+        // A. Aguarda o deadline do quadro (em turbo, o lote cobre vários quadros emulados).
+        // Parada em FX0A sem tecla na fila: nenhuma instrução roda até a próxima tecla,
+        // então a thread dorme sem espera ativa e a janela a acorda ao enfileirar uma tecla
+        const bool rewinding = context->rewinding.load(std::memory_order_relaxed);
+        const bool turbo = context->turbo.load(std::memory_order_relaxed) && !rewinding;
+        scheduler.set_speed(turbo ? turbo_speed : 1);
+        TimedKeyEvent next_key;
+        const bool blocked = emulator.is_waiting_for_key() && !turbo && !context->input->queue->peek(&next_key);
+        uint32_t frames_due = blocked ? scheduler.wait_for_frames_blocked() : scheduler.wait_for_frames();
+
+        // B. Pedidos da janela (F5, F9, F12) e SIGUSR1, entre quadros
+        if (context->dump_requested.exchange(false) || (emulator.get_trace() && ExecutionTrace::consume_dump_request())) {
+            dump_trace(emulator);
+        }
+        if (context->save_requested.exchange(false)) {
+            save_state_to(emulator, context->state_path);
+        }
+        if (context->load_requested.exchange(false) && load_state_from(emulator, context->state_path)) {
+            context->rewind_buffer->clear();
+        }
+
+        // C. Emula os quadros vencidos; cada um cobre uma fatia da janela de tempo real
+        // desde o último lote, e as teclas caem no ciclo proporcional ao seu instante.
+        // Em turbo as teclas da janela valem todas no início do lote.
+        const uint64_t window_end_ns = SDL_GetTicksNS();
+        const uint64_t window_ns = turbo ? 0 : window_end_ns - window_start_ns;
+        const uint64_t slice_start_ns = turbo ? window_end_ns : window_start_ns;
+        for (uint32_t frame = 0; frame < frames_due || scheduler.take_extra_frame(); ++frame) {
+            const uint64_t frame_start_ns = slice_start_ns + window_ns * frame / frames_due;
+            const uint64_t frame_end_ns = slice_start_ns + window_ns * (frame + 1) / frames_due;
+            if (rewinding) {
+                // Backspace pressionado: restaura quadros anteriores em vez de emular
+                apply_due_keys(emulator, *context->input, context->emulated_frames, frame_end_ns);
+                if (context->rewind_buffer->step_back(REWIND_FRAMES_PER_TICK, rewind_state)) {
+                    emulator.load_state(rewind_state);
+                }
+                continue;
+            }
+
+            // Ciclos da CPU em lote (Fetch-Decode-Execute); FX0A interrompe o lote
+            uint32_t frame_cycles = scheduler.cycles_for_frame();
+            scheduler.add_executed_cycles(run_frame_with_input(emulator, *context->input, context->emulated_frames,
+                                                               frame_cycles, frame_start_ns, frame_end_ns));
+
+            // Periféricos (60Hz) em tempo emulado
+            emulator.update_timers();
+            ++context->emulated_frames;
+
+            if (rewind_bytes > 0 && !turbo) {
+                emulator.save_state(rewind_state);
+                context->rewind_buffer->push(rewind_state);
+            }
+        }
+        window_start_ns = window_end_ns;
+        if (rewind_bytes > 0 && turbo) {
+            // Em turbo o histórico guarda um estado por quadro real
+            emulator.save_state(rewind_state);
+            context->rewind_buffer->push(rewind_state);
+        }
+
+        // D. Publica o quadro se a tela mudou; a janela apresenta o mais recente quando puder
+        PresentedFrame& slot = context->frames->get_write_slot();
+        if (emulator.take_frame(slot.pixels)) {
+            slot.latency_tag_ns = context->input->latency->on_frame_published(slot.pixels);
+            context->frames->publish();
+            if (!context->frame_event_pending.exchange(true)) {
+                SDL_Event wake{};
+                wake.type = context->frame_ready_event;
+                SDL_PushEvent(&wake);
+            }
+        }
+    }
+}
+#endif // CHIP8_HEADLESS
+
 int main(int argc, char* argv[]) {
     // --- 1. CONFIGURAÇÃO INICIAL E PARSE DE ARGUMENTOS ---
+    register_aot_programs(); // ROMs pré-compiladas (CHIP8_AOT_ROMS) para --engine aot
     const char* rom_path = nullptr;
     uint32_t clock_hz = parse_args(argc, argv, &rom_path, DEFAULT_CPU_HZ);
 
     if (!rom_path) {
         std::cerr << "ERRO: Forneca o caminho para o arquivo ROM (.ch8) como argumento." << std::endl;
-        std::cerr << "Uso: ./chip8_emulator [--clock <hz>] [--scale <N>] <caminho/para/a/rom.ch8>" << std::endl;
+        std::cerr << "Uso: ./chip8_emulator [--clock <hz>] [--scale <N>] [--engine interp|jit|aot] [--machine chip8|schip|xochip] [--log-level <nivel>] [--trace <arquivo>] [--load-state <arquivo>] [--save-state <arquivo>] [--rewind <KB>] [--audio square|sine|off] [--seed <N>] [--record <arquivo>] [--profile <arquivo.csv|.json> [--profile-top <N>]] [--cpu-core <N>] [--turbo <N|max>] [--headless [--cycles <N>] [--frames <N>] [--input <roteiro>] [--wav <arquivo>] | --replay <arquivo> [--wav <arquivo>]] <caminho/para/a/rom.ch8>" << std::endl;
         return 1;
     }
 
+    // Gravação sem --seed: sorteia uma semente e a guarda no arquivo
+    if (record_path && !seed_given) {
+        rng_seed = (uint32_t)std::time(nullptr);
+        seed_given = true;
+    }
+
+    // Modo headless: nenhuma chamada à SDL (nem SDL_Init)
+    if (headless_mode) {
+        // Replay: clock, semente, teclas e duração vêm da gravação
+        InputRecording replay;
+        if (replay_path) {
+            if (!replay.load(replay_path)) return 1;
+            clock_hz = replay.clock_hz;
+            rng_seed = replay.seed;
+            seed_given = true;
+            machine_profile = (MachineProfile)replay.machine;
+            if (cycle_budget == 0 && frame_budget == 0) frame_budget = replay.frames;
+        }
+
+        Chip8 emulator(clock_hz);
+        emulator.set_machine(machine_profile);
+        if (seed_given) emulator.set_rng_seed(rng_seed);
+        emulator.load_rom(rom_path, 0x200);
+        emulator.set_engine(cpu_engine);
+        if (load_state_path && !load_state_from(emulator, load_state_path)) {
+            return 1;
+        }
+        if (trace_path) {
+            emulator.enable_trace(DEFAULT_TRACE_CAPACITY, trace_path);
+            ExecutionTrace::install_signal_handlers(emulator.get_trace());
+        }
+        if (profile_path) emulator.enable_profiler();
+        if (cpu_core >= 0) pin_current_thread(cpu_core);
+        InputScript input_script;
+        if (input_script_path && !input_script.load(input_script_path)) {
+            return 1;
+        }
+        const std::vector<InputEvent>* input_events = replay_path ? &replay.events
+                                                    : input_script_path ? &input_script.get_events() : nullptr;
+        WavWriter wav(audio_waveform);
+        if (wav_path && !wav.open(wav_path)) {
+            return 1;
+        }
+        HeadlessConfig config{clock_hz, cycle_budget, frame_budget, input_events, wav_path ? &wav : nullptr};
+        HeadlessResult headless_result;
+        int result = run_headless(emulator, config, &headless_result);
+        if (trace_path) dump_trace(emulator);
+        if (wav_path) {
+            if (!wav.close()) return 1;
+            std::cout << "Audio gravado em " << wav_path << " (" << wav.get_sample_count() << " amostras, hash 0x"
+                      << std::hex << std::setw(16) << std::setfill('0') << wav.get_hash() << std::dec << std::setfill(' ')
+                      << ")" << std::endl;
+        }
+        if (profile_path) report_profile(emulator);
+
+        uint64_t final_hash = hash_framebuffer(emulator.get_pixel_buffer());
+        if (replay_path) {
+            bool identical = final_hash == replay.framebuffer_hash;
+            std::cout << "Replay de " << replay_path << ": framebuffer "
+                      << (identical ? "identico a gravacao" : "DIVERGENTE da gravacao")
+                      << " (" << replay.events.size() << " eventos, " << replay.frames << " quadros gravados)" << std::endl;
+            if (!identical) result = 1;
+        }
+        if (record_path) {
+            // Headless: a gravação reproduz o roteiro de entrada (aplicado no início de cada quadro)
+            InputRecording recording;
+            recording.machine = (uint8_t)machine_profile;
+            recording.seed = rng_seed;
+            recording.clock_hz = clock_hz;
+            recording.frames = headless_result.frames;
+            recording.cycles = headless_result.cycles;
+            recording.framebuffer_hash = final_hash;
+            if (input_events) recording.events = *input_events;
+            if (!recording.save(record_path)) return 1;
+            std::cout << "Gravacao de entrada salva em " << record_path << std::endl;
+        }
+        if (save_state_path && !save_state_to(emulator, save_state_path)) {
+            return 1;
+        }
+        return result;
+    }
+
+#ifndef CHIP8_HEADLESS
+
     // Inicializar SDL (VÍDEO E EVENTOS)
 if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) { // <--- SDL_INIT_AUDIO NECESSÁRIO
         std::cerr << "ERRO SDL: Falha ao inicializar SDL: " << SDL_GetError() << std::endl;
@@ -72,6 +566,8 @@ if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) { // <--- S
     
     // --- 2. PREPARAÇÃO DA VM, GRÁFICOS E CARREGAMENTO ---
     Chip8 emulator(clock_hz); 
+    emulator.set_machine(machine_profile);
+    if (seed_given) emulator.set_rng_seed(rng_seed);
     emulator.load_rom(rom_path, 0x200); 
 
     // Inicializar o Display com as configurações de escala
@@ -80,79 +576,155 @@ if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) { // <--- S
         return 1;
     }
 
-    // Variáveis para Validação (Issue 6 - Medição da Performance TOTAL)
-    long long cycles_executed_total = 0;
-    auto start_time = high_resolution_clock::now(); // Tempo em que o loop principal começa
+    // Sem dispositivo de áudio a emulação segue em silêncio
+    if (audio_enabled && !emulator.init_audio(audio_waveform)) {
+        std::cerr << "AVISO: Continuando sem som." << std::endl;
+    }
 
-    // Tempo alvo para CADA ciclo da CPU (1/N Hz)
-    const auto CPU_CYCLE_DURATION = duration_cast<microseconds>(seconds(1)) / clock_hz; 
-    
-    auto last_60hz_tick = high_resolution_clock::now();
-    bool quit = false;
+    emulator.set_engine(cpu_engine);
+    if (trace_path) {
+        emulator.enable_trace(DEFAULT_TRACE_CAPACITY, trace_path);
+        ExecutionTrace::install_signal_handlers(emulator.get_trace());
+    }
+    if (profile_path) emulator.enable_profiler();
+    if (load_state_path && !load_state_from(emulator, load_state_path)) {
+        emulator.destroy_audio();
+        emulator.destroy_display_graphics();
+        SDL_Quit();
+        return 1;
+    }
+    const char* hotkey_state_path = save_state_path ? save_state_path : DEFAULT_STATE_PATH;
+
+    // Histórico para voltar no tempo (Backspace): um save state compactado por quadro
+    RewindBuffer rewind_buffer(rewind_bytes, DEFAULT_REWIND_KEYFRAME_INTERVAL);
+
+    // Gravação para replay: cada transição de tecla com o quadro e o ciclo atuais.
+    // Voltar no tempo ou carregar um estado quebraria o replay e fica desligado.
+    InputRecording recording;
+    if (record_path) {
+        recording.machine = (uint8_t)machine_profile;
+        recording.seed = rng_seed;
+        recording.clock_hz = clock_hz;
+        rewind_bytes = 0;
+        LOG_INFO("Gravando entrada em %s (semente %u). Rewind e F9 desligados.", record_path, (unsigned)rng_seed);
+    }
+
+    // Teclas da janela: fila SPSC com o instante de cada transição, aplicada pela CPU
+    // no ciclo correspondente a esse instante dentro do quadro
+    InputQueue input_queue;
+    LatencyMeter latency_meter;
+    FrameInputContext input_context{&input_queue, record_path ? &recording : nullptr, &latency_meter};
+
+    // Agendador por quadro: clock/60 instruções em lote por quadro de 60Hz, um único
+    // sleep por quadro e recuperação limitada após travamentos (Issue 6)
+    FrameScheduler scheduler(clock_hz, PERIPHERAL_HZ, MAX_CATCH_UP_FRAMES);
+
+    // CPU e apresentação em threads separadas, ligadas pelo buffer triplo de quadros
+    TripleBuffer<PresentedFrame> frames;
+    EmulationContext context;
+    context.emulator = &emulator;
+    context.scheduler = &scheduler;
+    context.input = &input_context;
+    context.rewind_buffer = &rewind_buffer;
+    context.frames = &frames;
+    context.state_path = hotkey_state_path;
+    context.frame_ready_event = SDL_RegisterEvents(1);
+    context.emulated_frames = 0;
+    context.turbo.store(turbo_at_start);
 
     std::cout << "Iniciando loop principal..." << std::endl;
-    while (!quit) {
-        auto cpu_start_time = high_resolution_clock::now();
+    std::thread cpu_thread(run_emulation, &context);
 
-        // A. Processar Input (SDL Events)
+    // Thread da janela: dorme até o próximo evento (tecla ou quadro publicado) e
+    // apresenta sempre o quadro mais recente, sem nunca bloquear a CPU
+    bool quit = false;
+    bool have_frame = false;
+    while (!quit) {
         SDL_Event event;
-        while (SDL_PollEvent(&event)) {
+        if (!SDL_WaitEvent(&event)) continue;
+        bool redraw = false;
+        do {
             if (event.type == SDL_EVENT_QUIT) {
                 quit = true; // Seta a flag para sair do loop
-            } else {
-                emulator.process_input(event);
+            } else if (event.type == context.frame_ready_event) {
+                context.frame_event_pending.store(false);
+            } else if (event.type == SDL_EVENT_WINDOW_EXPOSED) {
+                redraw = true; // O conteúdo da janela foi perdido: reapresenta
+            } else if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F12 && emulator.get_trace()) {
+                context.dump_requested.store(true); // Dump sob pedido
+            } else if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat && event.key.key == SDLK_F5) {
+                context.save_requested.store(true);
+            } else if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat && event.key.key == SDLK_F9 && !record_path) {
+                context.load_requested.store(true);
+            } else if (event.type == SDL_EVENT_KEY_DOWN && !event.key.repeat && event.key.key == SDLK_TAB) {
+                bool turbo = !context.turbo.load();
+                context.turbo.store(turbo);
+                LOG_INFO("Turbo %s.", turbo ? "ligado" : "desligado");
+            } else if ((event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP)
+                       && event.key.key == SDLK_BACKSPACE && rewind_bytes > 0) {
+                context.rewinding.store(event.type == SDL_EVENT_KEY_DOWN);
+            } else if ((event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_KEY_UP) && !event.key.repeat) {
+                // Repetição automática do SO não é uma nova transição
+                int key = emulator.map_key(event.key.key);
+                if (key >= 0 && !input_queue.push({event.key.timestamp, (uint8_t)key, event.type == SDL_EVENT_KEY_DOWN})) {
+                    LOG_WARN("Fila de entrada cheia: tecla descartada.");
+                } else if (key >= 0) {
+                    scheduler.wake(); // A CPU pode estar dormindo em FX0A
+                }
             }
-        }
+        } while (SDL_PollEvent(&event));
 
-        // B. Ciclo da CPU (Fetch-Decode-Execute)
-        if (!emulator.is_waiting_for_key()) { // <-- CORREÇÃO: Usando o getter
-            emulator.cycle(); 
-            cycles_executed_total++;
+        // Apresentação: o quadro mais recente publicado (os intermediários são descartados)
+        if (frames.acquire()) {
+            have_frame = true;
+            redraw = true;
         }
-        emulator.cycle(); 
-        cycles_executed_total++; // Conta o ciclo executado
-
-        // C. Controle de Timing da CPU (Mantém a frequência em N Hz)
-        auto cpu_end_time = high_resolution_clock::now();
-        auto elapsed_cpu_time = duration_cast<microseconds>(cpu_end_time - cpu_start_time);
-        
-        if (elapsed_cpu_time < CPU_CYCLE_DURATION) {
-            std::this_thread::sleep_for(CPU_CYCLE_DURATION - elapsed_cpu_time);
-        }
-        
-        // D. Controle de Timing de Periféricos (60Hz)
-        auto now = high_resolution_clock::now();
-        auto elapsed_60hz_time = now - last_60hz_tick;
-
-        if (elapsed_60hz_time >= US_PER_60HZ_CYCLE) {
-            emulator.update_timers(); 
-            emulator.render_display();
-            last_60hz_tick = now;
+        if (redraw && have_frame) {
+            const PresentedFrame& frame = frames.get_read_slot();
+            emulator.present_frame(frame.pixels);
+            latency_meter.on_frame_presented(SDL_GetTicksNS(), frame.latency_tag_ns);
         }
-        
-        // ** NOTA: Lógica de VALIDAÇÃO REMOVIDA daqui **
     }
+    context.quit.store(true);
+    scheduler.wake();
+    cpu_thread.join();
+    const uint64_t emulated_frames = context.emulated_frames;
 
-    // --- 4. ENCERRAMENTO E VALIDAÇÃO FINAL ---
+    // --- 4. ENCERRAMENTO E RELATÓRIO ---
+    emulator.destroy_audio();
     emulator.destroy_display_graphics(); 
+
+    if (record_path) {
+        recording.frames = emulated_frames;
+        recording.cycles = emulator.get_cycle_count();
+        recording.framebuffer_hash = hash_framebuffer(emulator.get_pixel_buffer());
+        if (recording.save(record_path)) {
+            std::cout << "Gravacao de entrada salva em " << record_path << " (" << recording.events.size()
+                      << " eventos, " << emulated_frames << " quadros). Reproduza com --replay." << std::endl;
+        }
+    }
     
-    // Calcula o tempo total de execução e a frequência média final
-    auto end_time = high_resolution_clock::now();
-    auto total_duration = duration_cast<seconds>(end_time - start_time);
-    
-    // Evita divisão por zero se a duração total for zero
-    if (total_duration.count() > 0) {
-        double average_actual_hz = (double)cycles_executed_total / total_duration.count();
+    // Frequência média alcançada (tempo real com resolução sub-segundo)
+    double total_seconds = scheduler.get_elapsed_seconds();
+    if (total_seconds > 0.0) {
         std::cout << "\n=================================================" << std::endl;
-        std::cout << "VALIDACAO FINAL (ISSUE 6 - PERFORMANCE):" << std::endl;
-        std::cout << "Tempo total de execucao: " << total_duration.count() << " segundos." << std::endl;
-        std::cout << "Total de ciclos executados: " << cycles_executed_total << std::endl;
-        std::cout << "Frequencia media da CPU: " << std::fixed << std::setprecision(2) 
-                  << average_actual_hz << " Hz (Alvo: " << clock_hz << " Hz)." << std::endl;
+        std::cout << "RELATORIO DE EXECUCAO" << std::endl;
+        std::cout << "Tempo total de execucao: " << std::fixed << std::setprecision(3) << total_seconds << " segundos." << std::endl;
+        std::cout << "Total de ciclos executados: " << scheduler.get_executed_cycles() << std::endl;
+        if (emulator.get_idle_cycles_elided() > 0) {
+            std::cout << "Ciclos pulados em lacos de espera: " << emulator.get_idle_cycles_elided() << std::endl;
+        }
+        std::cout << "Quadros emulados: " << scheduler.get_emulated_frames()
+                  << " (descartados por atraso: " << scheduler.get_dropped_frames() << ")" << std::endl;
+        std::cout << "Frequencia media da CPU: " << std::setprecision(2) 
+                  << scheduler.get_achieved_hz() << " Hz (Alvo: " << clock_hz << " Hz)." << std::endl;
+        latency_meter.print_report(std::cout);
         std::cout << "=================================================" << std::endl;
     }
+    if (profile_path) report_profile(emulator);
     
     SDL_Quit();
     std::cout << "VM encerrada de forma limpa." << std::endl;
+#endif // CHIP8_HEADLESS
     return 0;
 }
\ No newline at end of file
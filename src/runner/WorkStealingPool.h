@@ -0,0 +1,54 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads com roubo de trabalho: cada worker tem sua própria fila
+// (consome pelo fim) e, quando ela esvazia, rouba tarefas do início da fila
+// de outro worker. Tarefas longas (ROMs pesadas, clocks altos) não deixam
+// os outros núcleos ociosos no fim do lote.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned thread_count); // 0 = núcleos do host
+    ~WorkStealingPool();
+
+    void submit(Task task); // Distribui as tarefas entre as filas em rodízio (thread produtora única)
+    void wait_idle();       // Bloqueia até todas as tarefas enviadas terminarem
+
+    unsigned get_thread_count() const { return (unsigned)workers.size(); }
+    uint64_t get_steal_count() const { return steals.load(); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(unsigned index);
+    bool pop_local(unsigned index, Task& task);
+    bool steal(unsigned thief, Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex state_mutex;                 // Protege as esperas abaixo
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    std::atomic<size_t> queued{0};          // Tarefas nas filas
+    std::atomic<size_t> pending{0};         // Tarefas enviadas e ainda não concluídas
+    std::atomic<uint64_t> steals{0};
+    unsigned next_queue = 0;
+    bool stopping = false;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,64 @@
+// Recompilador estático (ahead-of-time): carrega a ROM como o emulador
+// (load_rom, inclusive "arquivo.zip:ENTRADA"), desmonta o código alcançável e
+// grava uma unidade de tradução C++ com uma função por bloco básico. O CMake
+// roda esta ferramenta para cada ROM de CHIP8_AOT_ROMS e compila o resultado
+// no emulador (--engine aot).
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include "Chip8.h"
+#include "Log.h"
+#include "aot/AotTranslator.h"
+
+// Identificador C++ a partir do nome do arquivo: "roms/Space Invaders.ch8" -> "Space_Invaders"
+static std::string program_name_from_path(const char* path) {
+    std::string name(path);
+    const char* zip_separator = std::strstr(path, ".zip:");
+    if (zip_separator) name = zip_separator + 5;
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos && dot > 0) name = name.substr(0, dot);
+    for (char& c : name) {
+        if (!std::isalnum((unsigned char)c)) c = '_';
+    }
+    if (name.empty() || std::isdigit((unsigned char)name[0])) name = "_" + name;
+    return name;
+}
+
+int main(int argc, char* argv[]) {
+    const char* rom_path = nullptr;
+    const char* output_path = nullptr;
+    std::string name;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (argv[i][0] != '-') {
+            if (!rom_path) rom_path = argv[i];
+            else output_path = argv[i];
+        }
+    }
+    if (!rom_path || !output_path) {
+        std::fprintf(stderr, "Uso: ./chip8_aot [--name <identificador>] <rom.ch8> <saida.cpp>\n");
+        return 1;
+    }
+    if (name.empty()) name = program_name_from_path(rom_path);
+
+    // Só os avisos interessam (ex.: ROM carregada com sucesso não)
+    Log::set_level(LogLevel::Warn);
+    Chip8 chip(500);
+    chip.load_rom(rom_path);
+
+    std::ofstream out(output_path);
+    AotTranslationStats stats{};
+    if (!out.is_open() || !translate_rom(chip, name.c_str(), out, stats) || !out.good()) {
+        std::fprintf(stderr, "ERRO: Nao foi possivel gravar o codigo gerado em: %s\n", output_path);
+        return 1;
+    }
+
+    std::printf("AOT '%s': %zu blocos, %zu de %zu instrucoes traduzidas, %zu deixadas para o interpretador -> %s\n",
+                name.c_str(), stats.blocks, stats.translated, stats.reachable, stats.fallbacks, output_path);
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Benchmark do motor em lote (SoA + AVX2): executa a mesma ROM em N lanes com
+// sementes distintas e mede a vazão agregada (instruções/s) para cada número de
+// lanes. Com --verify roda também N instâncias Chip8 independentes (interpretador)
+// e confere o framebuffer final de cada lane.
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Chip8.h"
+#include "Headless.h"
+#include "Log.h"
+#include "batch/BatchEngine.h"
+
+constexpr uint32_t BATCH_PERIPHERAL_HZ = 60;
+
+std::vector<uint32_t> lane_counts;
+uint32_t clock_hz = 10000;
+uint64_t frame_count = 600;
+uint32_t base_seed = 1;
+bool verify = false;
+bool vector_enabled = true;
+const char* rom_path = nullptr;
+
+struct BatchRun {
+    uint64_t instructions; // Ciclos emulados (conferidos entre o lote e a referência)
+    double seconds;
+    uint64_t idle_cycles;  // Pulados em laços de espera pela referência: fora da vazão
+};
+
+static bool parse_lanes(const char* list) {
+    std::string text(list);
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) end = text.size();
+        try {
+            unsigned long value = std::stoul(text.substr(start, end - start));
+            if (value == 0 || value > 65536) throw std::out_of_range("lanes");
+            lane_counts.push_back((uint32_t)value);
+        } catch (const std::exception& e) {
+            std::cerr << "ERRO de argumento: --lanes invalido ('" << list << "')." << std::endl;
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+static bool parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        try {
+            if (strcmp(argv[i], "--lanes") == 0 && i + 1 < argc) {
+                if (!parse_lanes(argv[++i])) return false;
+            }
+            else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+                clock_hz = (uint32_t)std::stoul(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                frame_count = std::stoull(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                base_seed = (uint32_t)std::stoul(argv[++i], nullptr, 0);
+            }
+            else if (strcmp(argv[i], "--verify") == 0) {
+                verify = true;
+            }
+            else if (strcmp(argv[i], "--no-avx2") == 0) {
+                vector_enabled = false;
+            }
+            else if (argv[i][0] != '-') {
+                rom_path = argv[i];
+            }
+            else {
+                std::cerr << "ERRO de argumento: opcao desconhecida ('" << argv[i] << "')." << std::endl;
+                return false;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "ERRO de argumento: valor invalido para " << argv[i - 1] << " ('" << argv[i] << "')." << std::endl;
+            return false;
+        }
+    }
+    if (lane_counts.empty()) lane_counts = {1, 8, 32, 128, 512, 2048};
+    return rom_path != nullptr && clock_hz > 0;
+}
+
+// Mesmo laço por quadro do modo headless: clock/60 passos e um tique dos timers
+static BatchRun run_batch(BatchEngine& engine) {
+    uint64_t instructions = 0;
+    uint32_t cycle_remainder = 0;
+    auto start_time = std::chrono::steady_clock::now();
+    for (uint64_t frame = 0; frame < frame_count; ++frame) {
+        cycle_remainder += clock_hz;
+        instructions += engine.run_cycles(cycle_remainder / BATCH_PERIPHERAL_HZ);
+        cycle_remainder %= BATCH_PERIPHERAL_HZ;
+        engine.update_timers();
+    }
+    auto end_time = std::chrono::steady_clock::now();
+    return {instructions, std::chrono::duration<double>(end_time - start_time).count(), 0};
+}
+
+// Referência: uma instância Chip8 por lane, executadas uma após a outra
+static BatchRun run_reference(uint32_t lanes, const BatchEngine& engine, uint32_t* mismatches) {
+    uint64_t instructions = 0;
+    uint64_t idle_cycles = 0;
+    double seconds = 0.0;
+    *mismatches = 0;
+    for (uint32_t lane = 0; lane < lanes; ++lane) {
+        Chip8 emulator(clock_hz);
+        emulator.set_rng_seed(base_seed + lane);
+        emulator.load_rom(rom_path, 0x200);
+
+        uint32_t cycle_remainder = 0;
+        auto start_time = std::chrono::steady_clock::now();
+        for (uint64_t frame = 0; frame < frame_count; ++frame) {
+            cycle_remainder += clock_hz;
+            uint32_t frame_cycles = cycle_remainder / BATCH_PERIPHERAL_HZ;
+            cycle_remainder %= BATCH_PERIPHERAL_HZ;
+            if (!emulator.is_waiting_for_key()) {
+                instructions += emulator.run_cycles(frame_cycles);
+            }
+            emulator.update_timers();
+        }
+        auto end_time = std::chrono::steady_clock::now();
+        seconds += std::chrono::duration<double>(end_time - start_time).count();
+        idle_cycles += emulator.get_idle_cycles_elided();
+
+        bool same = hash_framebuffer(emulator.get_pixel_buffer()) == hash_framebuffer(engine.get_pixel_buffer(lane))
+                 && emulator.get_PC() == engine.get_PC(lane) && emulator.get_I() == engine.get_I(lane);
+        for (uint8_t r = 0; r < 16 && same; ++r) {
+            same = emulator.get_V(r) == engine.get_V(lane, r);
+        }
+        if (!same) ++*mismatches;
+    }
+    return {instructions, seconds, idle_cycles};
+}
+
+int main(int argc, char* argv[]) {
+    // Mensagens de cada instância de referência só poluiriam a tabela
+    Log::set_level(LogLevel::Warn);
+    if (!parse_args(argc, argv)) {
+        std::cerr << "Uso: ./chip8_batch_bench [--lanes <n,n,...>] [--clock <hz>] [--frames <N>] [--seed <N>]"
+                  << " [--verify] [--no-avx2] <rom.ch8>" << std::endl;
+        return 1;
+    }
+
+    std::cout << "BENCHMARK DO MOTOR EM LOTE: " << rom_path << " @ " << clock_hz << "Hz, "
+              << frame_count << " quadros" << std::endl;
+    std::cout << "AVX2: " << (BatchEngine::has_avx2() ? (vector_enabled ? "ativo" : "desativado (--no-avx2)")
+                                                     : "indisponivel no host") << std::endl;
+    std::cout << std::setw(7) << "Lanes" << std::setw(14) << "Instrucoes" << std::setw(10) << "Tempo(s)"
+              << std::setw(15) << "Instr/s" << std::setw(11) << "Vetorial";
+    if (verify) std::cout << std::setw(15) << "Chip8 instr/s" << std::setw(9) << "Ganho" << "  Verificacao";
+    std::cout << std::endl;
+
+    bool all_match = true;
+    for (uint32_t lanes : lane_counts) {
+        BatchEngine engine(lanes);
+        engine.set_vector_enabled(vector_enabled);
+        if (!engine.load_rom(rom_path)) return 1;
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            engine.set_rng_seed(lane, base_seed + lane);
+        }
+
+        BatchRun run = run_batch(engine);
+        double rate = run.seconds > 0 ? run.instructions / run.seconds : 0.0;
+        uint64_t vector_part = engine.get_vector_instructions();
+        uint64_t total_part = vector_part + engine.get_scalar_instructions();
+
+        std::cout << std::setw(7) << lanes << std::setw(14) << run.instructions
+                  << std::setw(10) << std::fixed << std::setprecision(3) << run.seconds
+                  << std::setw(15) << std::setprecision(0) << rate
+                  << std::setw(10) << std::setprecision(1)
+                  << (total_part ? 100.0 * vector_part / total_part : 0.0) << "%";
+
+        if (verify) {
+            uint32_t mismatches = 0;
+            BatchRun reference = run_reference(lanes, engine, &mismatches);
+            double reference_rate = reference.seconds > 0
+                ? (reference.instructions - reference.idle_cycles) / reference.seconds : 0.0;
+            std::cout << std::setw(15) << std::setprecision(0) << reference_rate
+                      << std::setw(8) << std::setprecision(2) << (reference_rate > 0 ? rate / reference_rate : 0.0) << "x"
+                      << "  " << (mismatches == 0 ? "OK" : "DIVERGENTE")
+                      << " (" << (lanes - mismatches) << "/" << lanes << ")";
+            if (mismatches != 0 || reference.instructions != run.instructions) all_match = false;
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+    return all_match ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+// Suite de benchmarks do caminho quente: cada ROM da biblioteca e programas
+// sintéticos por classe de opcode (ALU 8XYN, DXYN, FX55/FX65, saltos/chamadas),
+// em cada motor disponível, sem limitação de velocidade. Cada medição é repetida
+// e resumida por mediana, mínimo/máximo e desvio padrão; o resultado pode ser
+// gravado em JSON/CSV para acompanhar regressões ao longo do tempo. O estado
+// final de cada motor é conferido contra o do interpretador.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Chip8.h"
+#include "Headless.h"
+#include "Log.h"
+#include "aot/AotEngine.h"
+#include "jit/JitCompiler.h"
+#include "library/RomLibrary.h"
+
+constexpr uint32_t KEY_PRESS_INTERVAL = 30; // Quadros entre toques de tecla automáticos nas ROMs
+constexpr uint32_t KEY_PRESS_LENGTH = 5;    // Quadros com a tecla pressionada
+
+// Um caso de benchmark: ROM da biblioteca ou programa sintético
+struct BenchCase {
+    std::string name;
+    std::string kind;          // "rom" ou "micro"
+    const RomEntry* rom;       // nullptr nos sintéticos
+    std::vector<uint8_t> program;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string kind;
+    std::string engine;
+    uint64_t instructions;     // Executadas por repetição (igual em todas: execução determinística)
+    uint64_t idle_cycles;      // Ciclos pulados em laços de espera: fora de instructions e das taxas
+    uint64_t frames;
+    double median_ips;         // Instruções/s
+    double min_ips;
+    double max_ips;
+    double stddev_ips;
+    double ns_per_instruction; // Da mediana
+    double frames_per_second;  // Da mediana
+    const char* exit_reason;   // ROMs podem parar antes (FX0A sem entrada, laço de parada)
+    uint64_t state_hash;       // Framebuffer + registradores ao final: iguais em todos os motores
+};
+
+uint32_t clock_hz = 500000;
+uint64_t frame_count = 300;
+uint32_t repeat_count = 5;
+bool run_roms = true;
+bool run_micro = true;
+std::vector<CpuEngine> engines;
+const char* json_path = nullptr;
+const char* csv_path = nullptr;
+std::vector<std::string> rom_args;
+RomLibrary library;
+
+// --- Programas sintéticos (laços infinitos; o orçamento de quadros encerra) ---
+
+// ALU: todas as operações 8XYN e 7XNN em sequência
+static const uint8_t MICRO_ALU[] = {
+    0x60, 0x01, 0x61, 0x03, 0x62, 0x07, 0x63, 0x0F,       // 0x200: V0..V3 iniciais
+    0x80, 0x14, 0x81, 0x25, 0x82, 0x31, 0x83, 0x02,       // 0x208: ADD, SUB, OR, AND
+    0x80, 0x33, 0x81, 0x06, 0x82, 0x0E, 0x83, 0x17,       // 0x210: XOR, SHR, SHL, SUBN
+    0x84, 0x10, 0x70, 0x01, 0x71, 0x05, 0x12, 0x08        // 0x218: LD, ADD byte, JP 0x208
+};
+
+// DXYN: sprites de 5 linhas da fonte em posições que mudam a cada volta
+static const uint8_t MICRO_DRAW[] = {
+    0x60, 0x00, 0x61, 0x00, 0x62, 0x07,                   // 0x200: V0=x, V1=y, V2=dígito
+    0xF2, 0x29, 0xD0, 0x15, 0x70, 0x05, 0xD0, 0x15,       // 0x206: I=fonte(V2), DRW, x+=5, DRW
+    0x71, 0x03, 0xD0, 0x15, 0x72, 0x01, 0x12, 0x06        // 0x20E: y+=3, DRW, dígito+1, JP 0x206
+};
+
+// FX55/FX65: cópias de 16 registradores entre memória e V0-VF
+static const uint8_t MICRO_MEMORY[] = {
+    0x60, 0x11, 0x6F, 0x22,                               // 0x200: V0, VF iniciais
+    0xA3, 0x00, 0xFF, 0x55, 0xA3, 0x10, 0xFF, 0x55,       // 0x204: I=0x300 FX55, I=0x310 FX55
+    0xA3, 0x00, 0xFF, 0x65, 0x70, 0x01, 0x12, 0x04        // 0x20C: I=0x300 FX65, V0+1, JP 0x204
+};
+
+// FX65 com I além de 0xFFF: o endereço dá a volta (& 0xFFF) em todos os motores
+static const uint8_t MICRO_MEMORY_WRAP[] = {
+    0xAF, 0xF0, 0x60, 0x20, 0xF0, 0x1E,                   // 0x200: I=0xFF0, V0=0x20, I+=V0 (0x1010)
+    0xF1, 0x65, 0x12, 0x00                                // 0x206: FX65 (lê 0x010), JP 0x200
+};
+
+// Código automodificável escrito por FX55 com I além de 0xFFF: a escrita em
+// (I + i) & 0xFFF troca a constante de 0x220 e invalida o bloco já compilado
+static const uint8_t MICRO_SELF_MODIFY_WRAP[] = {
+    0x6A, 0x00, 0x60, 0x7A, 0x61, 0x01,                   // 0x200: VA=0, V0=0x7A, V1=1
+    0x62, 0xFF, 0xAF, 0x23, 0xF2, 0x1E, 0xF2, 0x1E,       // 0x206: V2=0xFF, I=0xF23, I+=V2, I+=V2
+    0xF2, 0x1E, 0xF1, 0x55, 0x71, 0x01, 0x12, 0x20,       // 0x20E: I+=V2 (0x1220), FX55 (grava 0x220), V1+1, JP 0x220
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x216: (sem uso)
+    0x7A, 0x01, 0x12, 0x06                                // 0x220: VA+=nn (reescrito), JP 0x206
+};
+
+// Saltos, chamadas e skips
+static const uint8_t MICRO_BRANCH[] = {
+    0x60, 0x00,                                           // 0x200: V0=0
+    0x22, 0x0C, 0x30, 0x01, 0x22, 0x0E, 0x40, 0x00,       // 0x202: CALL 0x20C, SE, CALL 0x20E, SNE
+    0x12, 0x02,                                           // 0x20A: JP 0x202
+    0x00, 0xEE,                                           // 0x20C: RET
+    0x12, 0x10, 0x00, 0xEE                                // 0x20E: JP 0x210, RET
+};
+
+static const char* engine_name(CpuEngine engine) {
+    return engine == CpuEngine::Jit ? "jit" : engine == CpuEngine::Aot ? "aot" : "interp";
+}
+
+static void print_usage() {
+    std::cerr << "Uso: ./chip8_bench [--engine interp|jit|aot|all] [--clock <hz>] [--frames <N>] [--repeat <N>]"
+              << " [--micro-only | --roms-only] [--json <arquivo>] [--csv <arquivo>] [<rom | arquivo.zip | diretorio>...]"
+              << std::endl;
+}
+
+static bool parse_args(int argc, char* argv[]) {
+    bool engine_given = false;
+    for (int i = 1; i < argc; ++i) {
+        try {
+            if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+                ++i;
+                engine_given = true;
+                if (strcmp(argv[i], "interp") == 0) {
+                    engines = {CpuEngine::Interpreter};
+                } else if (strcmp(argv[i], "jit") == 0) {
+                    engines = {CpuEngine::Jit};
+                } else if (strcmp(argv[i], "aot") == 0) {
+                    engines = {CpuEngine::Aot};
+                } else if (strcmp(argv[i], "all") == 0) {
+                    engine_given = false;
+                } else {
+                    std::cerr << "ERRO de argumento: --engine invalido ('" << argv[i] << "')." << std::endl;
+                    return false;
+                }
+            }
+            else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+                clock_hz = (uint32_t)std::stoul(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                frame_count = std::stoull(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+                repeat_count = (uint32_t)std::stoul(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--micro-only") == 0) {
+                run_roms = false;
+            }
+            else if (strcmp(argv[i], "--roms-only") == 0) {
+                run_micro = false;
+            }
+            else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+                json_path = argv[++i];
+            }
+            else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+                csv_path = argv[++i];
+            }
+            else if (argv[i][0] != '-') {
+                rom_args.push_back(argv[i]);
+            }
+            else {
+                std::cerr << "ERRO de argumento: opcao desconhecida ('" << argv[i] << "')." << std::endl;
+                return false;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "ERRO de argumento: valor invalido para " << argv[i - 1] << " ('" << argv[i] << "')." << std::endl;
+            return false;
+        }
+    }
+    if (!engine_given) {
+        engines = {CpuEngine::Interpreter};
+        if (JitCompiler::is_supported()) engines.push_back(CpuEngine::Jit);
+        if (AotEngine::program_count() > 0) engines.push_back(CpuEngine::Aot);
+    }
+    if (rom_args.empty()) rom_args.push_back("roms");
+    return clock_hz > 0 && frame_count > 0 && repeat_count > 0 && (run_roms || run_micro);
+}
+
+static std::vector<BenchCase> collect_cases() {
+    std::vector<BenchCase> cases;
+    if (run_micro) {
+        cases.push_back({"alu_8xyn", "micro", nullptr, {std::begin(MICRO_ALU), std::end(MICRO_ALU)}});
+        cases.push_back({"draw_dxyn", "micro", nullptr, {std::begin(MICRO_DRAW), std::end(MICRO_DRAW)}});
+        cases.push_back({"mem_fx55_fx65", "micro", nullptr, {std::begin(MICRO_MEMORY), std::end(MICRO_MEMORY)}});
+        cases.push_back({"mem_fx65_wrap", "micro", nullptr, {std::begin(MICRO_MEMORY_WRAP), std::end(MICRO_MEMORY_WRAP)}});
+        cases.push_back({"smc_fx55_wrap", "micro", nullptr, {std::begin(MICRO_SELF_MODIFY_WRAP), std::end(MICRO_SELF_MODIFY_WRAP)}});
+        cases.push_back({"branch_call", "micro", nullptr, {std::begin(MICRO_BRANCH), std::end(MICRO_BRANCH)}});
+    }
+    if (run_roms) {
+        for (const std::string& arg : rom_args) library.add_path(arg);
+        for (const RomEntry& entry : library.get_entries()) {
+            if (library.find_by_hash(entry.hash) != &entry) continue; // Conteúdo repetido
+            cases.push_back({entry.name, "rom", &entry, {}});
+        }
+    }
+    return cases;
+}
+
+// Toques de tecla periódicos (0-F em rodízio): mantém jogos que aguardam tecla rodando
+static std::vector<InputEvent> make_key_presses() {
+    std::vector<InputEvent> events;
+    for (uint64_t frame = KEY_PRESS_INTERVAL, key = 0; frame < frame_count; frame += KEY_PRESS_INTERVAL, ++key) {
+        events.push_back({frame, 0, (uint8_t)(key & 0xF), true});
+        events.push_back({frame + KEY_PRESS_LENGTH, 0, (uint8_t)(key & 0xF), false});
+    }
+    return events;
+}
+
+// Hash FNV-1a do estado final (framebuffer, V0-VF, I, PC): compara os motores entre si
+static uint64_t hash_state(const Chip8& emulator) {
+    uint64_t hash = hash_framebuffer(emulator.get_pixel_buffer());
+    auto mix = [&hash](uint32_t value) {
+        hash ^= value;
+        hash *= 0x100000001B3ULL;
+    };
+    for (uint8_t r = 0; r < 16; ++r) mix(emulator.get_V(r));
+    mix(emulator.get_I());
+    mix(emulator.get_PC());
+    return hash;
+}
+
+// AOT só mede casos com programa pré-compilado (os outros seriam o interpretador)
+static bool engine_available(const BenchCase& bench, CpuEngine engine) {
+    if (engine != CpuEngine::Aot) return true;
+    Chip8 emulator(clock_hz);
+    if (bench.rom) {
+        emulator.load_rom(library, *bench.rom, 0x200);
+    } else {
+        emulator.load_program(bench.program.data(), bench.program.size(), 0x200);
+    }
+    return AotEngine::find_program(emulator.get_memory().data()) != nullptr;
+}
+
+static HeadlessResult run_once(const BenchCase& bench, CpuEngine engine, const std::vector<InputEvent>& key_presses,
+                               uint64_t* state_hash = nullptr) {
+    Chip8 emulator(clock_hz);
+    emulator.set_rng_seed(1);
+    if (bench.rom) {
+        emulator.load_rom(library, *bench.rom, 0x200);
+    } else {
+        emulator.load_program(bench.program.data(), bench.program.size(), 0x200);
+    }
+    emulator.set_engine(engine);
+    HeadlessConfig config{clock_hz, 0, frame_count, bench.rom ? &key_presses : nullptr, nullptr};
+    HeadlessResult result = execute_headless(emulator, config);
+    if (state_hash) *state_hash = hash_state(emulator);
+    return result;
+}
+
+static BenchResult measure(const BenchCase& bench, CpuEngine engine, const std::vector<InputEvent>& key_presses) {
+    uint64_t state_hash = 0;
+    run_once(bench, engine, key_presses, &state_hash); // Aquecimento (caches, blocos do JIT, páginas)
+
+    std::vector<double> rates;
+    HeadlessResult run{};
+    for (uint32_t r = 0; r < repeat_count; ++r) {
+        run = run_once(bench, engine, key_presses);
+        rates.push_back(run.seconds > 0 ? (run.cycles - run.idle_cycles) / run.seconds : 0.0);
+    }
+    std::vector<double> sorted = rates;
+    std::sort(sorted.begin(), sorted.end());
+    double median = sorted.size() % 2 ? sorted[sorted.size() / 2]
+                                      : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+    double mean = 0.0;
+    for (double rate : rates) mean += rate;
+    mean /= rates.size();
+    double variance = 0.0;
+    for (double rate : rates) variance += (rate - mean) * (rate - mean);
+    double stddev = rates.size() > 1 ? std::sqrt(variance / (rates.size() - 1)) : 0.0;
+
+    const uint64_t executed = run.cycles - run.idle_cycles;
+    double seconds_at_median = median > 0 ? executed / median : 0.0;
+    return {bench.name, bench.kind, engine_name(engine), executed, run.idle_cycles, run.frames, median,
+            sorted.front(), sorted.back(), stddev,
+            median > 0 ? 1e9 / median : 0.0,
+            seconds_at_median > 0 ? run.frames / seconds_at_median : 0.0, run.exit_reason, state_hash};
+}
+
+static std::string json_escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+static void write_json(const std::vector<BenchResult>& results) {
+    std::ofstream json(json_path);
+    if (!json.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel criar o arquivo JSON: " << json_path << std::endl;
+        return;
+    }
+    json << std::fixed << std::setprecision(3);
+    json << "{\n  \"timestamp\": " << (long long)std::time(nullptr) << ",\n"
+         << "  \"clock_hz\": " << clock_hz << ",\n  \"frames\": " << frame_count << ",\n"
+         << "  \"repeat\": " << repeat_count << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        json << "    {\"name\": \"" << json_escape(r.name) << "\", \"kind\": \"" << r.kind
+             << "\", \"engine\": \"" << r.engine << "\", \"instructions\": " << r.instructions
+             << ", \"idle_cycles\": " << r.idle_cycles
+             << ", \"frames\": " << r.frames << ", \"ips_median\": " << r.median_ips
+             << ", \"ips_min\": " << r.min_ips << ", \"ips_max\": " << r.max_ips
+             << ", \"ips_stddev\": " << r.stddev_ips << ", \"ns_per_instruction\": " << r.ns_per_instruction
+             << ", \"frames_per_second\": " << r.frames_per_second
+             << ", \"exit_reason\": \"" << r.exit_reason << "\"}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    std::cout << "JSON gravado em " << json_path << std::endl;
+}
+
+static void write_csv(const std::vector<BenchResult>& results) {
+    std::ofstream csv(csv_path);
+    if (!csv.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel criar o arquivo CSV: " << csv_path << std::endl;
+        return;
+    }
+    csv << "name,kind,engine,instructions,idle_cycles,frames,ips_median,ips_min,ips_max,ips_stddev,ns_per_instruction,frames_per_second,exit_reason\n";
+    csv << std::fixed << std::setprecision(3);
+    for (const BenchResult& r : results) {
+        csv << r.name << ',' << r.kind << ',' << r.engine << ',' << r.instructions << ',' << r.idle_cycles << ',' << r.frames << ','
+            << r.median_ips << ',' << r.min_ips << ',' << r.max_ips << ',' << r.stddev_ips << ','
+            << r.ns_per_instruction << ',' << r.frames_per_second << ",\"" << r.exit_reason << "\"\n";
+    }
+    std::cout << "CSV gravado em " << csv_path << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    Log::set_level(LogLevel::Warn);
+    register_aot_programs(); // ROMs pré-compiladas (CHIP8_AOT_ROMS) para --engine aot
+    if (!parse_args(argc, argv)) {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<BenchCase> cases = collect_cases();
+    std::vector<InputEvent> key_presses = make_key_presses();
+
+    std::cout << "BENCHMARK: " << cases.size() << " casos x " << engines.size() << " motor(es), "
+              << frame_count << " quadros @ " << clock_hz << "Hz, mediana de " << repeat_count << " repeticoes" << std::endl;
+    std::cout << std::left << std::setw(28) << "Caso" << std::right << std::setw(8) << "Motor"
+              << std::setw(12) << "Instrucoes" << std::setw(14) << "Instr/s" << std::setw(10) << "ns/instr" << std::setw(12) << "Quadros/s"
+              << std::setw(9) << "Desvio" << std::endl;
+
+    std::vector<BenchResult> results;
+    int exit_code = 0;
+    for (const BenchCase& bench : cases) {
+        uint64_t reference_hash = 0;
+        for (CpuEngine engine : engines) {
+            if (!engine_available(bench, engine)) continue;
+            BenchResult result = measure(bench, engine, key_presses);
+            // Todos os motores devem terminar no mesmo estado que o primeiro (interpretador)
+            if (engine == engines.front()) {
+                reference_hash = result.state_hash;
+            } else if (result.state_hash != reference_hash) {
+                std::cerr << "ERRO: " << bench.name << ": estado final do motor " << result.engine
+                          << " difere do motor " << engine_name(engines.front()) << std::endl;
+                exit_code = 1;
+            }
+            std::string label = bench.name.size() > 27 ? "..." + bench.name.substr(bench.name.size() - 24) : bench.name;
+            std::cout << std::left << std::setw(28) << label << std::right << std::setw(8) << result.engine
+                      << std::setw(12) << result.instructions << std::fixed << std::setprecision(0) << std::setw(14) << result.median_ips
+                      << std::setprecision(2) << std::setw(10) << result.ns_per_instruction
+                      << std::setprecision(0) << std::setw(12) << result.frames_per_second
+                      << std::setprecision(1) << std::setw(8)
+                      << (result.median_ips > 0 ? 100.0 * result.stddev_ips / result.median_ips : 0.0) << "%"
+                      << std::defaultfloat << std::endl;
+            results.push_back(result);
+        }
+    }
+
+    if (json_path) write_json(results);
+    if (csv_path) write_csv(results);
+    return exit_code;
+}
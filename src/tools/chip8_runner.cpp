@@ -0,0 +1,287 @@
+// Runner paralelo: executa várias ROMs x clocks x roteiros de entrada em modo
+// headless, uma VM Chip8 por tarefa, distribuídas em um pool com roubo de trabalho.
+// Reporta o hash do framebuffer de cada tarefa e a vazão agregada (instruções/s).
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Chip8.h"
+#include "Headless.h"
+#include "InputScript.h"
+#include "Log.h"
+#include "aot/AotProgram.h"
+#include "library/RomLibrary.h"
+#include "runner/WorkStealingPool.h"
+
+namespace fs = std::filesystem;
+
+constexpr uint32_t DEFAULT_RUNNER_CLOCK = 500;
+
+// Uma combinação ROM x clock x roteiro
+struct RunnerJob {
+    const RomEntry* rom;             // Entrada da biblioteca (arquivo solto ou zip)
+    uint32_t clock_hz;
+    const InputScript* input_script; // nullptr = sem entrada
+};
+
+struct RunnerResult {
+    HeadlessResult headless;
+    uint64_t framebuffer_hash;
+    const char* fault_message; // Erro fatal da ROM (tarefa parada), nullptr se não houve
+};
+
+// Configuração do lote (preenchida por parse_args)
+unsigned thread_count = 0;
+std::vector<uint32_t> clocks;
+uint64_t cycle_budget = 0;
+uint64_t frame_budget = 0;
+CpuEngine cpu_engine = CpuEngine::Interpreter;
+uint32_t rng_seed = 1;
+const char* csv_path = nullptr;
+std::vector<std::string> script_paths;
+std::vector<std::string> rom_args;
+const char* rom_cache_path = nullptr; // --rom-cache <arquivo>: índice das ROMs por hash
+bool keep_duplicates = false;         // --keep-duplicates: roda ROMs com conteúdo repetido
+RomLibrary library;
+
+static void print_usage() {
+    std::cerr << "Uso: ./chip8_runner [--threads <N>] [--clocks <hz,hz,...>] [--cycles <N>] [--frames <N>]"
+              << " [--engine interp|jit|aot] [--input <roteiro>]... [--seed <N>] [--csv <arquivo>]"
+              << " [--rom-cache <arquivo>] [--keep-duplicates] <rom.ch8 | arquivo.zip | diretorio>..." << std::endl;
+}
+
+static bool parse_clocks(const char* list) {
+    std::string text(list);
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) end = text.size();
+        try {
+            unsigned long value = std::stoul(text.substr(start, end - start));
+            if (value == 0) throw std::invalid_argument("zero");
+            clocks.push_back((uint32_t)value);
+        } catch (const std::exception& e) {
+            std::cerr << "ERRO de argumento: --clocks invalido ('" << list << "')." << std::endl;
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+static bool parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        try {
+            if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                thread_count = (unsigned)std::stoul(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--clocks") == 0 && i + 1 < argc) {
+                if (!parse_clocks(argv[++i])) return false;
+            }
+            else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+                cycle_budget = std::stoull(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+                frame_budget = std::stoull(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                rng_seed = (uint32_t)std::stoul(argv[++i], nullptr, 0);
+            }
+            else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+                script_paths.push_back(argv[++i]);
+            }
+            else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+                csv_path = argv[++i];
+            }
+            else if (strcmp(argv[i], "--rom-cache") == 0 && i + 1 < argc) {
+                rom_cache_path = argv[++i];
+            }
+            else if (strcmp(argv[i], "--keep-duplicates") == 0) {
+                keep_duplicates = true;
+            }
+            else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+                ++i;
+                if (strcmp(argv[i], "jit") == 0) {
+                    cpu_engine = CpuEngine::Jit;
+                } else if (strcmp(argv[i], "aot") == 0) {
+                    cpu_engine = CpuEngine::Aot; // ROMs sem programa pré-compilado usam o interpretador
+                } else if (strcmp(argv[i], "interp") == 0) {
+                    cpu_engine = CpuEngine::Interpreter;
+                } else {
+                    std::cerr << "ERRO de argumento: --engine invalido ('" << argv[i] << "')." << std::endl;
+                    return false;
+                }
+            }
+            else if (argv[i][0] != '-') {
+                rom_args.push_back(argv[i]);
+            }
+            else {
+                std::cerr << "ERRO de argumento: opcao desconhecida ('" << argv[i] << "')." << std::endl;
+                return false;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "ERRO de argumento: valor invalido para " << argv[i - 1] << " ('" << argv[i] << "')." << std::endl;
+            return false;
+        }
+    }
+    if (clocks.empty()) clocks.push_back(DEFAULT_RUNNER_CLOCK);
+    return !rom_args.empty();
+}
+
+// Monta a biblioteca (arquivos soltos, .zip e diretórios, mapeados em memória)
+// e descarta ROMs cujo conteúdo (hash) já apareceu antes
+static std::vector<const RomEntry*> collect_roms() {
+    if (rom_cache_path) library.load_cache(rom_cache_path);
+    for (const std::string& arg : rom_args) library.add_path(arg);
+    if (rom_cache_path) library.save_cache(rom_cache_path);
+
+    std::vector<const RomEntry*> roms;
+    size_t duplicates = 0;
+    for (const RomEntry& entry : library.get_entries()) {
+        if (!keep_duplicates && library.find_by_hash(entry.hash) != &entry) {
+            ++duplicates;
+            continue;
+        }
+        roms.push_back(&entry);
+    }
+    if (duplicates) {
+        std::cout << duplicates << " ROM(s) com conteudo repetido ignorada(s) (use --keep-duplicates)." << std::endl;
+    }
+    return roms;
+}
+
+static RunnerResult run_job(const RunnerJob& job) {
+    Chip8 emulator(job.clock_hz);
+    emulator.set_exit_on_fault(false); // Uma ROM com erro para só a própria tarefa
+    emulator.set_rng_seed(rng_seed);
+    emulator.load_rom(library, *job.rom, 0x200);
+    emulator.set_engine(cpu_engine);
+
+    HeadlessConfig config{job.clock_hz, cycle_budget, frame_budget,
+                          job.input_script ? &job.input_script->get_events() : nullptr, nullptr};
+    RunnerResult result;
+    result.headless = execute_headless(emulator, config);
+    result.framebuffer_hash = hash_framebuffer(emulator.get_pixel_buffer());
+    result.fault_message = emulator.get_fault_message();
+    return result;
+}
+
+static void write_csv(const std::vector<RunnerJob>& jobs, const std::vector<RunnerResult>& results) {
+    std::ofstream csv(csv_path);
+    if (!csv.is_open()) {
+        std::cerr << "ERRO: Nao foi possivel criar o arquivo CSV: " << csv_path << std::endl;
+        return;
+    }
+    csv << "rom,clock_hz,input,cycles,frames,seconds,cycles_per_second,framebuffer_hash,exit_reason,idle_cycles\n";
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const RunnerJob& job = jobs[i];
+        const HeadlessResult& run = results[i].headless;
+        // Vazão só das instruções executadas (os ciclos pulados em laços de espera não custam tempo)
+        double rate = run.seconds > 0 ? (run.cycles - run.idle_cycles) / run.seconds : 0.0;
+        csv << job.rom->name << ',' << job.clock_hz << ','
+            << (job.input_script ? job.input_script->get_path() : "") << ','
+            << run.cycles << ',' << run.frames << ',' << run.seconds << ','
+            << (uint64_t)rate << ",0x" << std::hex << std::setw(16) << std::setfill('0')
+            << results[i].framebuffer_hash << std::dec << std::setfill(' ') << ','
+            << '"' << run.exit_reason;
+        if (results[i].fault_message) csv << ": " << results[i].fault_message;
+        csv << '"' << ',' << run.idle_cycles << '\n';
+    }
+    std::cout << "CSV gravado em " << csv_path << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Mensagens de cada VM (ROM carregada etc.) só poluiriam o relatório
+    Log::set_level(LogLevel::Warn);
+    register_aot_programs(); // ROMs pré-compiladas (CHIP8_AOT_ROMS) para --engine aot
+    if (!parse_args(argc, argv)) {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<InputScript> scripts(script_paths.size());
+    for (size_t i = 0; i < script_paths.size(); ++i) {
+        if (!scripts[i].load(script_paths[i])) return 1;
+    }
+
+    std::vector<const RomEntry*> roms = collect_roms();
+    if (roms.empty()) {
+        std::cerr << "ERRO: Nenhuma ROM valida encontrada." << std::endl;
+        return 1;
+    }
+
+    // Produto cartesiano ROM x clock x roteiro
+    std::vector<RunnerJob> jobs;
+    for (const RomEntry* rom : roms) {
+        for (uint32_t clock_hz : clocks) {
+            if (scripts.empty()) {
+                jobs.push_back({rom, clock_hz, nullptr});
+            }
+            for (const InputScript& script : scripts) {
+                jobs.push_back({rom, clock_hz, &script});
+            }
+        }
+    }
+    std::vector<RunnerResult> results(jobs.size());
+
+    uint64_t steal_count = 0;
+    unsigned used_threads = 0;
+
+    auto start_time = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(thread_count);
+        used_threads = pool.get_thread_count();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            pool.submit([&jobs, &results, i] { results[i] = run_job(jobs[i]); });
+        }
+        pool.wait_idle();
+        steal_count = pool.get_steal_count();
+    }
+    auto end_time = std::chrono::steady_clock::now();
+
+    double wall_seconds = std::chrono::duration<double>(end_time - start_time).count();
+    uint64_t total_cycles = 0;
+    uint64_t total_idle_cycles = 0; // Pulados em laços de espera: fora da vazão
+    double cpu_seconds = 0.0;
+    size_t faulted_jobs = 0;
+
+    std::cout << "=================================================" << std::endl;
+    std::cout << "RELATORIO DO RUNNER (" << jobs.size() << " tarefas, " << used_threads << " threads)" << std::endl;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const RunnerJob& job = jobs[i];
+        const RunnerResult& result = results[i];
+        total_cycles += result.headless.cycles;
+        total_idle_cycles += result.headless.idle_cycles;
+        cpu_seconds += result.headless.seconds;
+
+        std::cout << fs::path(job.rom->name).filename().string() << " @ " << job.clock_hz << "Hz";
+        if (job.input_script) std::cout << " [" << job.input_script->get_path() << "]";
+        std::cout << ": hash 0x" << std::hex << std::setw(16) << std::setfill('0') << result.framebuffer_hash
+                  << std::dec << std::setfill(' ') << ", " << result.headless.cycles << " ciclos, "
+                  << result.headless.frames << " quadros, " << std::fixed << std::setprecision(3)
+                  << result.headless.seconds * 1000.0 << " ms (" << result.headless.exit_reason;
+        if (result.fault_message) {
+            std::cout << ": " << result.fault_message;
+            ++faulted_jobs;
+        }
+        std::cout << ")" << std::defaultfloat << std::endl;
+    }
+    std::cout << "-------------------------------------------------" << std::endl;
+    std::cout << "Ciclos totais: " << total_cycles << " (pulados em lacos de espera: " << total_idle_cycles << ")" << std::endl;
+    std::cout << "Tempo real: " << std::fixed << std::setprecision(3) << wall_seconds << " s"
+              << " (soma por tarefa: " << cpu_seconds << " s)" << std::endl;
+    if (wall_seconds > 0) {
+        std::cout << "Vazao agregada: " << std::setprecision(0) << (total_cycles - total_idle_cycles) / wall_seconds
+                  << " instrucoes/s" << std::endl;
+    }
+    std::cout << std::defaultfloat << "Tarefas roubadas entre workers: " << steal_count << std::endl;
+    if (faulted_jobs) std::cout << "Tarefas paradas por erro fatal da ROM: " << faulted_jobs << std::endl;
+    std::cout << "=================================================" << std::endl;
+
+    if (csv_path) write_csv(jobs, results);
+    return faulted_jobs ? 1 : 0;
+}
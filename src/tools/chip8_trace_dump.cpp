@@ -0,0 +1,63 @@
+// Decodificador do trace binário de execução (--trace): lista cada instrução
+// registrada com PC, opcode, mnemônico e os registradores alterados.
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Disassembler.h"
+#include "ExecutionTrace.h"
+
+static std::string describe_changes(const TraceRecord& record) {
+    std::string text;
+    char item[24];
+    int shown = 0;
+    for (int r = 0; r < 16; ++r) {
+        if (!(record.changed & (1u << r))) continue;
+        if (shown < 2) {
+            std::snprintf(item, sizeof(item), "V%X=%02X ", r, record.values[shown]);
+        } else {
+            std::snprintf(item, sizeof(item), "V%X ", r); // Valor não registrado (ex.: FX65)
+        }
+        text += item;
+        ++shown;
+    }
+    return text;
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = nullptr;
+    size_t last = 0; // 0 = todos os registros
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--last") == 0 && i + 1 < argc) {
+            last = std::strtoul(argv[++i], nullptr, 10);
+        } else if (argv[i][0] != '-') {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        std::fprintf(stderr, "Uso: ./chip8_trace_dump [--last <N>] <trace.bin>\n");
+        return 1;
+    }
+
+    TraceFileHeader header;
+    std::vector<TraceRecord> records;
+    if (!ExecutionTrace::load(path, &header, &records)) {
+        std::fprintf(stderr, "ERRO: Trace invalido ou ilegivel: %s\n", path);
+        return 1;
+    }
+
+    std::printf("Trace: %s (%u registros; %llu instrucoes registradas no total)\n", path,
+                header.record_count, (unsigned long long)header.total_recorded);
+    std::printf("%-10s %-6s %-6s %-18s %-6s %-3s %s\n", "SEQ", "PC", "OPCODE", "INSTRUCAO", "I", "SP", "ALTERACOES");
+
+    size_t first = (last != 0 && last < records.size()) ? records.size() - last : 0;
+    for (size_t k = first; k < records.size(); ++k) {
+        const TraceRecord& record = records[k];
+        std::string changes = describe_changes(record);
+        if (record.flags & TRACE_FLAG_KEY_WAIT) changes += "[aguardando tecla] ";
+        if (record.flags & TRACE_FLAG_FAULT) changes += "[ERRO FATAL] ";
+        std::printf("%-10u 0x%03X  %04X   %-18s 0x%03X %-3u %s\n", record.sequence, record.pc, record.opcode,
+                    disassemble(record.opcode).c_str(), record.i, record.sp, changes.c_str());
+    }
+    return 0;
+}